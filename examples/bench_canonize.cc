@@ -0,0 +1,116 @@
+/**
+ * @date 2026/10/16.
+ *
+ * @brief Microbenchmark of the canonization of Zone and BasicPackedZone
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "packed_zone.hh"
+
+namespace {
+  using namespace learnta;
+
+  //! @brief Satisfiable random DBMs constraining a random point
+  std::vector<Zone> randomZones(Eigen::Index size, std::size_t number, std::mt19937 &engine) {
+    std::uniform_int_distribution<int> point{0, 100}, slack{0, 10}, coin{0, 3};
+    std::vector<Zone> zones;
+    zones.reserve(number);
+    while (zones.size() < number) {
+      std::vector<int> valuation(size, 0);
+      for (Eigen::Index i = 1; i < size; ++i) {
+        valuation.at(i) = point(engine);
+      }
+      Zone zone = Zone::top(size);
+      zone.maxConstraints.assign(size - 1, 100);
+      for (Eigen::Index i = 0; i < size; ++i) {
+        for (Eigen::Index j = 0; j < size; ++j) {
+          if (i == j) {
+            zone.value(i, j) = Bounds{0, true};
+          } else if (coin(engine) != 0) {
+            zone.value(i, j) = Bounds{valuation.at(i) - valuation.at(j) + slack(engine), true};
+          }
+        }
+      }
+      zones.push_back(std::move(zone));
+    }
+    return zones;
+  }
+
+  //! @brief Returns the average time in nanoseconds to canonize a copy of each zone
+  template<class ZoneType, class Canonize>
+  double measure(const std::vector<ZoneType> &zones, std::size_t repetition, Canonize canonize) {
+    std::size_t satisfiable = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repetition; ++r) {
+      for (const auto &zone: zones) {
+        ZoneType copied = zone;
+        canonize(copied);
+        satisfiable += copied.isSatisfiableNoCanonize();
+      }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    // Use the result so that the canonization is not optimized away
+    if (satisfiable != repetition * zones.size()) {
+      std::cerr << "unexpected unsatisfiable zone" << std::endl;
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / double(repetition * zones.size());
+  }
+
+  //! @brief Measure the canonization of BasicPackedZone of a fixed size if the size is small. Otherwise, returns NaN.
+  template<int Dimension = 1>
+  double measureFixed(const std::vector<Zone> &zones, std::size_t repetition) {
+    if constexpr (Dimension <= maxFixedPackedZoneDimension) {
+      if (zones.front().value.cols() != Dimension) {
+        return measureFixed<Dimension + 1>(zones, repetition);
+      }
+      std::vector<BasicPackedZone<Dimension>> fixedZones;
+      fixedZones.reserve(zones.size());
+      for (const auto &zone: zones) {
+        fixedZones.emplace_back(zone);
+      }
+      return measure(fixedZones, repetition, [](BasicPackedZone<Dimension> &zone) { zone.canonize(); });
+    } else {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+}
+
+int main() {
+  constexpr std::size_t numZones = 1000;
+  std::mt19937 engine{2026};
+  const auto avx2 = packedCloseKernelAvx2();
+  if (!avx2) {
+    std::cout << "AVX2 is not available: the vectorized kernel is not measured" << std::endl;
+  }
+  std::cout << std::setw(6) << "size" << std::setw(12) << "Zone" << std::setw(12) << "scalar" << std::setw(12)
+            << "AVX2" << std::setw(12) << "default" << std::setw(12) << "fixed" << "  [ns per canonization]"
+            << std::endl;
+  for (const Eigen::Index size: {2, 3, 4, 5, 6, 8, 12, 16, 24, 32}) {
+    const auto zones = randomZones(size, numZones, engine);
+    std::vector<PackedZone> packedZones;
+    packedZones.reserve(zones.size());
+    for (const auto &zone: zones) {
+      packedZones.emplace_back(zone);
+    }
+    const std::size_t repetition = std::max<std::size_t>(1, 20000 / (size * size * size));
+    std::cout << std::setw(6) << size << std::fixed << std::setprecision(1);
+    std::cout << std::setw(12) << measure(zones, repetition, [](Zone &zone) { zone.canonize(); });
+    std::cout << std::setw(12) << measure(packedZones, repetition, [](PackedZone &zone) {
+      zone.canonize(closePackedDBM);
+    });
+    if (avx2) {
+      std::cout << std::setw(12) << measure(packedZones, repetition, [&](PackedZone &zone) { zone.canonize(avx2); });
+    } else {
+      std::cout << std::setw(12) << "-";
+    }
+    std::cout << std::setw(12) << measure(packedZones, repetition, [](PackedZone &zone) { zone.canonize(); });
+    std::cout << std::setw(12) << measureFixed(zones, repetition);
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
@@ -8,12 +8,16 @@
 #include <boost/log/trivial.hpp>
 #include <boost/log/core.hpp>
 #include <boost/log/expressions.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
 #include <utility>
 
 #include "timed_automaton.hh"
 #include "sul.hh"
 #include "timed_automaton_runner.hh"
 #include "symbolic_membership_oracle.hh"
+#include "parallel_membership_oracle.hh"
 #include "equivalence_oracle_by_test.hh"
 #include "timed_automata_equivalence_oracle.hh"
 #include "learner.hh"
@@ -27,12 +31,20 @@ namespace learnta {
     const std::vector<Alphabet> alphabet;
     TimedAutomaton target;
     std::vector<TimedWord> testWords;
+    std::size_t numThreads = 1;
   public:
 
     void pushTestWord(const TimedWord& testWord) {
       testWords.push_back(testWord);
     }
 
+    /*!
+     * @brief Set the number of threads to answer membership queries and to fill the observation table. If it is 0, we use the hardware concurrency.
+     */
+    void setNumThreads(std::size_t threads) {
+      this->numThreads = threads;
+    }
+
     ExperimentRunner(std::vector<Alphabet> alphabet, TimedAutomaton target) : alphabet(std::move(alphabet)), target(std::move(target)) {}
 
     /*!
@@ -47,7 +59,18 @@ namespace learnta {
 
       // Construct the learner
       auto sul = std::unique_ptr<learnta::SUL>(new learnta::TimedAutomatonRunner(this->target));
-      auto memOracle = std::make_unique<learnta::SymbolicMembershipOracle>(std::move(sul));
+      auto memOracle = (this->numThreads == 1) ?
+                       std::make_unique<learnta::SymbolicMembershipOracle>(std::move(sul)) :
+                       std::make_unique<learnta::SymbolicMembershipOracle>(
+                               std::make_unique<learnta::ParallelMembershipOracle>(std::move(sul), this->numThreads));
+      // The fingerprint of the target to detect the cache and the checkpoint of another target
+      std::stringstream description;
+      description << this->target;
+      const auto targetFingerprint = learnta::PersistentMembershipOracle::fingerprint(description.str());
+      // Reuse the answers of the membership queries in the previous runs if LEARNTA_MEMBERSHIP_CACHE is set
+      if (const char *cachePath = std::getenv("LEARNTA_MEMBERSHIP_CACHE")) {
+        memOracle->persist(cachePath, targetFingerprint);
+      }
       auto eqOracle = std::make_unique<learnta::EquivalenceOracleChain>();
       auto eqOracleByTest = std::make_unique<learnta::EquivalenceOracleByTest>(this->target);
       // Equivalence query by static string to make the evaluation stable
@@ -62,7 +85,19 @@ namespace learnta {
               std::make_unique<learnta::ComplementTimedAutomataEquivalenceOracle>(
                       this->target, complement, alphabet));
       learnta::Learner learner{alphabet, std::move(memOracle),
-                               std::make_unique<learnta::EquivalenceOracleMemo>(std::move(eqOracle), this->target)};
+                               std::make_unique<learnta::EquivalenceOracleMemo>(std::move(eqOracle), this->target),
+                               this->numThreads};
+      // Resume from and write checkpoints to LEARNTA_CHECKPOINT if it is set. A checkpoint of another target is rejected.
+      if (const char *checkpointPath = std::getenv("LEARNTA_CHECKPOINT")) {
+        if (std::filesystem::exists(checkpointPath)) {
+          learner.resume(checkpointPath, targetFingerprint);
+        }
+        learner.setCheckpoint(checkpointPath, targetFingerprint);
+      }
+      // Remove the redundant suffixes if LEARNTA_MINIMIZE_SUFFIXES is set
+      if (std::getenv("LEARNTA_MINIMIZE_SUFFIXES")) {
+        learner.setSuffixMinimization(true);
+      }
 
       // Run the learning
       BOOST_LOG_TRIVIAL(info) << "Start Learning!!";
@@ -121,6 +121,18 @@ namespace learnta {
       return fractionalOrder;
     }
 
+    //! @brief Write the language in the binary format
+    void save(BinaryWriter &writer) const {
+      ElementaryLanguage::save(writer);
+      this->fractionalOrder.save(writer);
+    }
+
+    //! @brief Read the language written by save
+    static BackwardRegionalElementaryLanguage load(BinaryReader &reader) {
+      auto elementary = ElementaryLanguage::load(reader);
+      return BackwardRegionalElementaryLanguage{std::move(elementary), FractionalOrder::load(reader)};
+    }
+
     bool operator==(const BackwardRegionalElementaryLanguage &another) const {
       return this->word == another.word && this->timedCondition == another.timedCondition &&
              this->fractionalOrder == another.fractionalOrder;
@@ -0,0 +1,97 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace learnta {
+  /*!
+   * @brief Writer of the binary format used for checkpoints
+   *
+   * The arithmetic values are written in the native byte order, and the sizes of the containers are written as uint64_t
+   * before their elements. The classes to be written provide save(BinaryWriter &).
+   */
+  class BinaryWriter {
+  private:
+    std::ostream &stream;
+
+  public:
+    explicit BinaryWriter(std::ostream &stream) : stream(stream) {}
+
+    template<class T>
+    std::enable_if_t<std::is_arithmetic_v<T>> write(T value) {
+      stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    void writeSize(std::size_t size) {
+      this->write(static_cast<std::uint64_t>(size));
+    }
+
+    void write(const std::string &string) {
+      this->writeSize(string.size());
+      stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+    }
+
+    template<class T>
+    std::enable_if_t<std::is_arithmetic_v<T>> write(const std::vector<T> &vector) {
+      this->writeSize(vector.size());
+      stream.write(reinterpret_cast<const char *>(vector.data()), static_cast<std::streamsize>(vector.size() * sizeof(T)));
+    }
+
+    //! @brief Returns if all the values are successfully written
+    [[nodiscard]] bool good() const {
+      return stream.good();
+    }
+  };
+
+  /*!
+   * @brief Reader of the binary format written by BinaryWriter
+   *
+   * @note We throw std::invalid_argument if the stream ends before the value is read.
+   */
+  class BinaryReader {
+  private:
+    std::istream &stream;
+
+    void readBytes(char *data, std::size_t size) {
+      if (!stream.read(data, static_cast<std::streamsize>(size))) {
+        throw std::invalid_argument("BinaryReader: the input is truncated");
+      }
+    }
+
+  public:
+    explicit BinaryReader(std::istream &stream) : stream(stream) {}
+
+    template<class T>
+    std::enable_if_t<std::is_arithmetic_v<T>, T> read() {
+      T value;
+      this->readBytes(reinterpret_cast<char *>(&value), sizeof(T));
+      return value;
+    }
+
+    std::size_t readSize() {
+      return static_cast<std::size_t>(this->read<std::uint64_t>());
+    }
+
+    std::string readString() {
+      std::string string(this->readSize(), '\0');
+      this->readBytes(string.data(), string.size());
+      return string;
+    }
+
+    template<class T>
+    std::enable_if_t<std::is_arithmetic_v<T>, std::vector<T>> readVector() {
+      std::vector<T> vector(this->readSize());
+      this->readBytes(reinterpret_cast<char *>(vector.data()), vector.size() * sizeof(T));
+      return vector;
+    }
+  };
+}
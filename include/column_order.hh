@@ -0,0 +1,62 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace learnta {
+  /*!
+   * @brief The order to check the columns of the observation table in the equivalence checks
+   *
+   * We use the move-to-front heuristic: when a column refutes the equivalence of two rows, we move it to the front so
+   * that the next checks try it first. Since a failing check stops at the first refuting column, a column distinguishing
+   * many rows is usually checked after one or two columns. The order changes only the efficiency, not the results.
+   *
+   * @note The methods can be called concurrently.
+   */
+  class ColumnOrder {
+  private:
+    //! @brief The permutation of the columns known so far
+    std::vector<std::size_t> permutation;
+    mutable std::mutex mutex;
+
+  public:
+    /*!
+     * @brief Returns the current order of the columns \f$0, 1, \dots, n - 1\f$
+     *
+     * The columns not seen before are appended in the ascending order.
+     */
+    [[nodiscard]] std::vector<std::size_t> columns(std::size_t n) {
+      std::lock_guard<std::mutex> lock{mutex};
+      while (permutation.size() < n) {
+        permutation.push_back(permutation.size());
+      }
+      std::vector<std::size_t> result;
+      result.reserve(n);
+      std::copy_if(permutation.begin(), permutation.end(), std::back_inserter(result), [&](std::size_t column) {
+        return column < n;
+      });
+      return result;
+    }
+
+    //! @brief Record that the column refuted an equivalence
+    void refute(std::size_t column) {
+      std::lock_guard<std::mutex> lock{mutex};
+      auto it = std::find(permutation.begin(), permutation.end(), column);
+      if (it != permutation.end()) {
+        std::rotate(permutation.begin(), it, std::next(it));
+      }
+    }
+
+    //! @brief Forget the order, e.g., when the columns are renumbered
+    void clear() {
+      std::lock_guard<std::mutex> lock{mutex};
+      permutation.clear();
+    }
+  };
+}
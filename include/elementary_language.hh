@@ -205,6 +205,18 @@ namespace learnta {
 
     friend std::ostream &operator<<(std::ostream &os, const ElementaryLanguage &language);
 
+    //! @brief Write the elementary language in the binary format
+    void save(BinaryWriter &writer) const {
+      writer.write(this->word);
+      this->timedCondition.save(writer);
+    }
+
+    //! @brief Read the elementary language written by save
+    static ElementaryLanguage load(BinaryReader &reader) {
+      auto word = reader.readString();
+      return ElementaryLanguage{std::move(word), TimedCondition::load(reader)};
+    }
+
     bool operator==(const ElementaryLanguage &another) const {
       return word == another.word && timedCondition == another.timedCondition;
     }
@@ -7,22 +7,80 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "elementary_language.hh"
 #include "backward_regional_elementary_language.hh"
 #include "timed_condition_set.hh"
 #include "juxtaposed_zone_set.hh"
 #include "renaming_relation.hh"
+#include "table_storage.hh"
+#include "thread_pool.hh"
+#include "column_order.hh"
 
 namespace learnta {
+  /*!
+   * @brief Returns the smallest index \f$i < n\f$ satisfying predicate(i), or \f$n\f$ if there is no such index
+   *
+   * If a thread pool is given, we evaluate the predicate concurrently. Once we find a satisfying index, we skip the
+   * larger indices, which are not evaluated yet. The result is the same as the sequential search.
+   *
+   * @pre predicate can be called concurrently
+   */
+  template<class Predicate>
+  static inline std::size_t findFirstIndex(std::size_t n, const Predicate &predicate, ThreadPool *pool) {
+    if (pool == nullptr || pool->size() == 1 || n <= 1) {
+      for (std::size_t i = 0; i < n; ++i) {
+        if (predicate(i)) {
+          return i;
+        }
+      }
+      return n;
+    }
+    std::atomic<std::size_t> found{n};
+    pool->parallelFor(n, [&](std::size_t i, std::size_t) {
+      if (i >= found.load(std::memory_order_relaxed)) {
+        // A smaller index already satisfies the predicate
+        return;
+      }
+      if (predicate(i)) {
+        auto current = found.load();
+        while (i < current && !found.compare_exchange_weak(current, i)) {}
+      }
+    });
+    return found;
+  }
+
+  /*!
+   * @brief Returns if none of the columns \f$0, 1, \dots, n - 1\f$ satisfies refutes(column)
+   *
+   * If the order is given, we check the columns in it and move the refuting column to the front.
+   */
+  template<class Refutes>
+  static inline bool noColumnRefutes(std::size_t n, const Refutes &refutes, ThreadPool *pool, ColumnOrder *order) {
+    if (order == nullptr) {
+      return findFirstIndex(n, refutes, pool) == n;
+    }
+    const auto columns = order->columns(n);
+    const auto position = findFirstIndex(n, [&](std::size_t k) {
+      return refutes(columns.at(k));
+    }, pool);
+    if (position < n) {
+      order->refute(columns.at(position));
+      return false;
+    }
+    return true;
+  }
+
   /*!
    * @brief Return if two elementary languages are equivalent
    *
    * @pre leftRow.size() == rightRow.size() == suffixes.size()
    */
   static bool equivalence(const ElementaryLanguage &left,
-                          const std::vector<TimedConditionSet> &leftRow,
+                          RowView<TimedConditionSet> leftRow,
                           const ElementaryLanguage &right,
-                          const std::vector<TimedConditionSet> &rightRow,
+                          RowView<TimedConditionSet> rightRow,
                           const std::vector<BackwardRegionalElementaryLanguage> &suffixes,
                           const RenamingRelation &renaming) {
 #ifdef LEARNTA_DEBUG_EQUIVALENCE
@@ -67,13 +125,15 @@ namespace learnta {
    * @pre leftRow.size() == rightRow.size() == suffixes.size()
    */
   static bool equivalence(const ElementaryLanguage &left,
-                          const std::vector<TimedConditionSet> &leftRow,
-                          const std::vector<TimedCondition>& leftConcatenation,
+                          RowView<TimedConditionSet> leftRow,
+                          RowView<TimedCondition> leftConcatenation,
                           const ElementaryLanguage &right,
-                          const std::vector<TimedConditionSet> &rightRow,
-                          const std::vector<TimedCondition>& rightConcatenation,
+                          RowView<TimedConditionSet> rightRow,
+                          RowView<TimedCondition> rightConcatenation,
                           const std::vector<BackwardRegionalElementaryLanguage> &suffixes,
-                          const RenamingRelation &renaming) {
+                          const RenamingRelation &renaming,
+                          ThreadPool *pool = nullptr,
+                          ColumnOrder *order = nullptr) {
 #ifdef LEARNTA_DEBUG_EQUIVALENCE
     BOOST_LOG_TRIVIAL(trace) << "left: " << left;
     BOOST_LOG_TRIVIAL(trace) << "right: " << right;
@@ -90,18 +150,14 @@ namespace learnta {
     if (!juxtaposition.isSatisfiableNoCanonize()) {
       return false;
     }
-    // Check the compatibility of symbolic membership up to renaming
-    for (std::size_t i = 0; i < leftRow.size(); ++i) {
+    // Check the compatibility of symbolic membership up to renaming. The suffixes are checked concurrently if possible.
+    return noColumnRefutes(leftRow.size(), [&](std::size_t i) {
       JuxtaposedZoneSet leftJuxtaposition{leftRow.at(i), rightConcatenation.at(i), suffixes.at(i).wordSize()};
       leftJuxtaposition.addRenaming(renaming);
       JuxtaposedZoneSet rightJuxtaposition{leftConcatenation.at(i), rightRow.at(i), suffixes.at(i).wordSize()};
       rightJuxtaposition.addRenaming(renaming);
-      if (leftJuxtaposition != rightJuxtaposition) {
-        return false;
-      }
-    }
-
-    return true;
+      return leftJuxtaposition != rightJuxtaposition;
+    }, pool, order);
   }
 
   /*!
@@ -116,21 +172,23 @@ namespace learnta {
    static bool equivalence(JuxtaposedZone leftRightJuxtaposition,
                            const std::vector<JuxtaposedZoneSet> &leftJuxtapositions,
                            const std::vector<JuxtaposedZoneSet> &rightJuxtapositions,
-                           const RenamingRelation &renaming) {
+                           const RenamingRelation &renaming,
+                           ThreadPool *pool = nullptr,
+                           ColumnOrder *order = nullptr) {
      assert(leftJuxtapositions.size() == rightJuxtapositions.size());
      // Check the compatibility of prefixes up to renaming
      leftRightJuxtaposition.addRenaming(renaming);
      if (!leftRightJuxtaposition) {
        return false;
      }
-     // Check the compatibility of symbolic membership up to renaming
-     return std::equal(leftJuxtapositions.begin(), leftJuxtapositions.end(),
-                       rightJuxtapositions.begin(), rightJuxtapositions.end(),
-                       [&renaming] (JuxtaposedZoneSet left, JuxtaposedZoneSet right) {
+     // Check the compatibility of symbolic membership up to renaming. The suffixes are checked concurrently if possible.
+     return noColumnRefutes(leftJuxtapositions.size(), [&](std::size_t i) {
+       auto left = leftJuxtapositions.at(i);
+       auto right = rightJuxtapositions.at(i);
        left.addRenaming(renaming);
        right.addRenaming(renaming);
-       return left == right;
-     });
+       return left != right;
+     }, pool, order);
    }
 
    using RenamingGraph = std::pair<std::vector<std::vector<std::size_t>>, std::vector<std::vector<std::size_t>>>;
@@ -284,11 +342,11 @@ namespace learnta {
    static inline CellStatus decideStatus(const TimedCondition &concatenation, const TimedConditionSet &cell) {
        // Assert the precondition
 #ifndef NDEBUG
-       const auto simpleConcatenations = concatenation.enumerate();
+       // We stop the enumeration once we find a simple condition not included in the cell
        assert((cell.size() == 1 && cell.getConditions().front() == concatenation) ||
-              std::any_of(simpleConcatenations.begin(), simpleConcatenations.end(), [&] (const TimedCondition& simple) {
-                  return std::none_of(cell.getConditions().begin(), cell.getConditions().end(),
-                                      [&] (const TimedCondition& disjunct) {
+              !concatenation.forEachSimple([&] (const TimedCondition& simple) {
+                  return std::any_of(cell.getConditions().begin(), cell.getConditions().end(),
+                                     [&] (const TimedCondition& disjunct) {
                       return disjunct.includes(simple);
                   });
               }));
@@ -316,10 +374,10 @@ namespace learnta {
     * @return The constrained variables in strictly ascending order
     */
    static inline std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
-   makeConstrainedVariables(const std::vector<TimedConditionSet> &leftRow,
-                            const std::vector<TimedConditionSet> &rightRow,
-                            const std::vector<TimedCondition> &leftConcatenations,
-                            const std::vector<TimedCondition> &rightConcatenations,
+   makeConstrainedVariables(RowView<TimedConditionSet> leftRow,
+                            RowView<TimedConditionSet> rightRow,
+                            RowView<TimedCondition> leftConcatenations,
+                            RowView<TimedCondition> rightConcatenations,
                             const std::size_t N,
                             const std::size_t M) {
        std::vector<std::size_t> constrainedV1, constrainedV2;
@@ -363,9 +421,9 @@ namespace learnta {
    * @pre left and right are simple
    */
   static inline std::optional<RenamingRelation> findDeterministicEquivalentRenaming(const ElementaryLanguage &left,
-                                                                                    const std::vector<TimedConditionSet> &leftRow,
+                                                                                    RowView<TimedConditionSet> leftRow,
                                                                                     const ElementaryLanguage &right,
-                                                                                    const std::vector<TimedConditionSet> &rightRow,
+                                                                                    RowView<TimedConditionSet> rightRow,
                                                                                     const std::vector<BackwardRegionalElementaryLanguage> &suffixes) {
     // 0. Asserts the preconditions
     assert(leftRow.size() == rightRow.size());
@@ -475,14 +533,18 @@ namespace learnta {
    *
    * @pre leftRow.size() == rightRow.size() == suffixes.size()
    * @pre left and right are simple
+   * @param pool If it is given, the candidates and the suffixes are checked concurrently with it
+   * @param order If it is given, the suffixes are checked in this order, which is updated by the refuting suffixes
    */
   static inline std::optional<RenamingRelation> findDeterministicEquivalentRenaming(const ElementaryLanguage &left,
-                                                                                    const std::vector<TimedConditionSet> &leftRow,
-                                                                                    const std::vector<TimedCondition>& leftConcatenations,
+                                                                                    RowView<TimedConditionSet> leftRow,
+                                                                                    RowView<TimedCondition> leftConcatenations,
                                                                                     const ElementaryLanguage &right,
-                                                                                    const std::vector<TimedConditionSet> &rightRow,
-                                                                                    const std::vector<TimedCondition>& rightConcatenations,
-                                                                                    const std::vector<BackwardRegionalElementaryLanguage> &suffixes) {
+                                                                                    RowView<TimedConditionSet> rightRow,
+                                                                                    RowView<TimedCondition> rightConcatenations,
+                                                                                    const std::vector<BackwardRegionalElementaryLanguage> &suffixes,
+                                                                                    ThreadPool *pool = nullptr,
+                                                                                    ColumnOrder *order = nullptr) {
     // 0. Asserts the preconditions
     assert(leftRow.size() == rightRow.size());
     assert(rightRow.size() == suffixes.size());
@@ -507,7 +569,7 @@ namespace learnta {
     // 1. Try the empty relation
     if (equivalence(left, leftRow, leftConcatenations,
                     right, rightRow, rightConcatenations,
-                    suffixes, RenamingRelation{})) {
+                    suffixes, RenamingRelation{}, pool, order)) {
       return RenamingRelation{};
     }
 
@@ -534,19 +596,27 @@ namespace learnta {
         candidate.addImplicitConstraints(leftRightJuxtaposition);
       }
     });
-    std::vector<JuxtaposedZoneSet> leftJuxtapositions, rightJuxtapositions;
-    leftJuxtapositions.reserve(leftRow.size());
-    rightJuxtapositions.reserve(rightRow.size());
-    for (std::size_t i = 0; i < leftRow.size(); ++i) {
-      leftJuxtapositions.emplace_back(leftRow.at(i), rightConcatenations.at(i), suffixes.at(i).wordSize());
-      rightJuxtapositions.emplace_back(leftConcatenations.at(i), rightRow.at(i), suffixes.at(i).wordSize());
+    std::vector<JuxtaposedZoneSet> leftJuxtapositions(leftRow.size()), rightJuxtapositions(rightRow.size());
+    const auto juxtapose = [&](std::size_t i, std::size_t) {
+      leftJuxtapositions.at(i) = JuxtaposedZoneSet{leftRow.at(i), rightConcatenations.at(i), suffixes.at(i).wordSize()};
+      rightJuxtapositions.at(i) = JuxtaposedZoneSet{leftConcatenations.at(i), rightRow.at(i), suffixes.at(i).wordSize()};
+    };
+    if (pool) {
+      pool->parallelFor(leftRow.size(), juxtapose);
+    } else {
+      for (std::size_t i = 0; i < leftRow.size(); ++i) {
+        juxtapose(i, 0);
+      }
     }
-    auto it = std::find_if(candidates.begin(), candidates.end(), [&](const auto &candidate) {
-      return equivalence(leftRightJuxtaposition, leftJuxtapositions, rightJuxtapositions, candidate);
-    });
-
-    if (it != candidates.end()) {
-      return *it;
+    // The candidates are tested concurrently if possible. If there are multiple witnesses, we return the first one as
+    // the sequential search, so that the learned model does not depend on the scheduling.
+    const auto found = findFirstIndex(candidates.size(), [&](std::size_t index) {
+      return equivalence(leftRightJuxtaposition, leftJuxtapositions, rightJuxtapositions, candidates.at(index), pool,
+                         order);
+    }, pool);
+
+    if (found < candidates.size()) {
+      return candidates.at(found);
     } else {
       return std::nullopt;
     }
@@ -576,9 +646,9 @@ namespace learnta {
      * @pre left and right are simple
      */
   static inline std::optional<RenamingRelation> findEquivalentRenaming(const ElementaryLanguage &left,
-                                                                       const std::vector<TimedConditionSet> &leftRow,
+                                                                       RowView<TimedConditionSet> leftRow,
                                                                        const ElementaryLanguage &right,
-                                                                       const std::vector<TimedConditionSet> &rightRow,
+                                                                       RowView<TimedConditionSet> rightRow,
                                                                        const std::vector<BackwardRegionalElementaryLanguage> &suffixes) {
     // 0. Asserts the preconditions
     assert(leftRow.size() == rightRow.size());
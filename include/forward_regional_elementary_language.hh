@@ -213,6 +213,18 @@ namespace learnta {
       return boost::hash_value(std::make_tuple(this->getWord(), this->getTimedCondition(),
                                                this->fractionalOrder.hash_value()));
     }
+
+    //! @brief Write the language in the binary format
+    void save(BinaryWriter &writer) const {
+      ElementaryLanguage::save(writer);
+      this->fractionalOrder.save(writer);
+    }
+
+    //! @brief Read the language written by save
+    static ForwardRegionalElementaryLanguage load(BinaryReader &reader) {
+      auto elementary = ElementaryLanguage::load(reader);
+      return ForwardRegionalElementaryLanguage{std::move(elementary), FractionalOrder::load(reader)};
+    }
   };
 
   static inline std::ostream &operator<<(std::ostream &os, const learnta::ForwardRegionalElementaryLanguage &lang) {
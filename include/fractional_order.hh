@@ -14,6 +14,7 @@
 #include <boost/log/expressions.hpp>
 
 #include "common_types.hh"
+#include "binary_serialization.hh"
 
 namespace learnta {
   /*!
@@ -206,6 +207,27 @@ namespace learnta {
     [[nodiscard]] std::size_t hash_value() const {
       return boost::hash_value(std::make_pair(this->order, this->size));
     }
+
+    //! @brief Write the fractional order in the binary format
+    void save(BinaryWriter &writer) const {
+      writer.writeSize(this->size);
+      writer.writeSize(this->order.size());
+      for (const auto &variables: this->order) {
+        writer.write(std::vector<ClockVariables>(variables.begin(), variables.end()));
+      }
+    }
+
+    //! @brief Read the fractional order written by save
+    static FractionalOrder load(BinaryReader &reader) {
+      FractionalOrder result;
+      result.size = reader.readSize();
+      result.order.resize(reader.readSize());
+      for (auto &variables: result.order) {
+        const auto readVariables = reader.readVector<ClockVariables>();
+        variables.assign(readVariables.begin(), readVariables.end());
+      }
+      return result;
+    }
   };
 
   static inline std::ostream &operator<<(std::ostream &os, const learnta::FractionalOrder &order) {
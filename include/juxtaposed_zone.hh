@@ -27,7 +27,8 @@ namespace learnta {
     JuxtaposedZone(const Zone &left, const Zone &right) :
             leftSize(static_cast<Eigen::Index>(left.getNumOfVar())),
             rightSize(static_cast<Eigen::Index>(right.getNumOfVar())) {
-      static boost::unordered_map<std::pair<Zone, Zone>, Eigen::Matrix<Bounds, Eigen::Dynamic, Eigen::Dynamic>> memo;
+      // The memo is thread-local so that we can juxtapose zones concurrently, e.g., in the equivalence checks
+      static thread_local boost::unordered_map<std::pair<Zone, Zone>, Eigen::Matrix<Bounds, Eigen::Dynamic, Eigen::Dynamic>> memo;
       const auto key = std::make_pair(left, right);
       auto it = memo.find(key);
       if (it != memo.end()) {
@@ -62,7 +63,7 @@ namespace learnta {
     JuxtaposedZone(const Zone &left, const Zone &right, Eigen::Index commonVariableSize) :
             leftSize(static_cast<Eigen::Index>(left.getNumOfVar())),
             rightSize(static_cast<Eigen::Index>(right.getNumOfVar())) {
-      static boost::unordered_map<std::tuple<Zone, Zone, Eigen::Index>, Eigen::Matrix<Bounds, Eigen::Dynamic, Eigen::Dynamic>> memoWithCommon;
+      static thread_local boost::unordered_map<std::tuple<Zone, Zone, Eigen::Index>, Eigen::Matrix<Bounds, Eigen::Dynamic, Eigen::Dynamic>> memoWithCommon;
       const auto key = std::make_tuple(left, right, commonVariableSize);
       auto it = memoWithCommon.find(key);
       if (it != memoWithCommon.end()) {
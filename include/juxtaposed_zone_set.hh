@@ -14,6 +14,8 @@ namespace learnta {
   private:
     std::vector<JuxtaposedZone> zones;
   public:
+    JuxtaposedZoneSet() = default;
+
     JuxtaposedZoneSet(const TimedConditionSet &left, const TimedCondition &right) {
       zones.resize(left.size());
       std::transform(left.getConditions().begin(), left.getConditions().end(), zones.begin(),
@@ -5,7 +5,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 
 #include "equivalence_oracle.hh"
 #include "symbolic_membership_oracle.hh"
@@ -19,11 +24,89 @@ namespace learnta {
   private:
     std::unique_ptr<EquivalenceOracle> eqOracle;
     ObservationTable observationTable;
+    //! @brief The path to write the checkpoints, if any
+    std::optional<std::filesystem::path> checkpointPath;
+    //! @brief The fingerprint of the target system written to the checkpoints
+    std::uint64_t checkpointFingerprint = 0;
+    //! @brief We write a checkpoint once every this number of hypotheses
+    std::size_t checkpointInterval = 1;
+    //! @brief The number of the hypotheses generated so far
+    std::size_t numHypotheses = 0;
+    //! @brief If we remove the redundant suffixes before generating each hypothesis
+    bool suffixMinimization = false;
+
+    /*!
+     * @brief Write the checkpoint
+     *
+     * We first write to a temporary file and rename it so that a crash during the writing does not break the previous
+     * checkpoint.
+     */
+    void writeCheckpoint() const {
+      auto temporaryPath = *checkpointPath;
+      temporaryPath += ".tmp";
+      {
+        std::ofstream stream{temporaryPath, std::ios::binary | std::ios::trunc};
+        observationTable.save(stream, checkpointFingerprint);
+        if (!stream) {
+          BOOST_LOG_TRIVIAL(error) << "Learner: failed to write the checkpoint to " << temporaryPath;
+          return;
+        }
+      }
+      std::filesystem::rename(temporaryPath, *checkpointPath);
+      BOOST_LOG_TRIVIAL(debug) << "Learner: wrote the checkpoint to " << *checkpointPath;
+    }
+
   public:
+    /*!
+     * @param numThreads The number of threads to fill the observation table. If it is 0, we use the number of the
+     * hardware threads.
+     */
     Learner(const std::vector<Alphabet> &alphabet,
             std::unique_ptr<SymbolicMembershipOracle> memOracle,
-            std::unique_ptr<EquivalenceOracle> eqOracle) : eqOracle(std::move(eqOracle)),
-                                                           observationTable(alphabet, std::move(memOracle)) {}
+            std::unique_ptr<EquivalenceOracle> eqOracle,
+            std::size_t numThreads = 1) : eqOracle(std::move(eqOracle)),
+                                          observationTable(alphabet, std::move(memOracle), numThreads) {}
+
+    /*!
+     * @brief Write a checkpoint of the observation table periodically during run()
+     *
+     * @param path The path to the checkpoint. It is overwritten by the latest checkpoint.
+     * @param targetFingerprint The value identifying the target system, e.g., PersistentMembershipOracle::fingerprint
+     * of its description
+     * @param interval We write a checkpoint once every this number of hypotheses.
+     */
+    void setCheckpoint(std::filesystem::path path, std::uint64_t targetFingerprint, std::size_t interval = 1) {
+      this->checkpointPath = std::move(path);
+      this->checkpointFingerprint = targetFingerprint;
+      this->checkpointInterval = std::max<std::size_t>(interval, 1);
+    }
+
+    /*!
+     * @brief Remove the redundant suffixes before generating each hypothesis
+     *
+     * The current hypothesis does not change, and the observation table is kept narrow. The later hypotheses may differ
+     * because the renaming witnesses found later are searched without the removed suffixes. It is disabled by default.
+     */
+    void setSuffixMinimization(bool enabled) {
+      this->suffixMinimization = enabled;
+    }
+
+    /*!
+     * @brief Restore the observation table from a checkpoint written by a previous run
+     *
+     * The membership queries answered in the checkpoint are not asked again.
+     *
+     * @param targetFingerprint The value identifying the target system given to setCheckpoint in the previous run
+     * @throws std::invalid_argument if the checkpoint cannot be read or is of another target
+     */
+    void resume(const std::filesystem::path &path, std::uint64_t targetFingerprint) {
+      std::ifstream stream{path, std::ios::binary};
+      if (!stream) {
+        throw std::invalid_argument("Learner::resume: failed to open " + path.string());
+      }
+      observationTable.load(stream, targetFingerprint);
+      BOOST_LOG_TRIVIAL(info) << "Learner: resumed from the checkpoint " << path;
+    }
 
     TimedAutomaton run() {
       while (true) {
@@ -35,6 +118,12 @@ namespace learnta {
           notUpdated = notUpdated && observationTable.timeSaturate();
           // notUpdated = notUpdated && observationTable.renameConsistent();
         } while (!notUpdated);
+        if (suffixMinimization) {
+          observationTable.minimizeSuffixes();
+        }
+        if (checkpointPath && ++numHypotheses % checkpointInterval == 0) {
+          this->writeCheckpoint();
+        }
         BOOST_LOG_TRIVIAL(debug) << "Start DTA generation";
         auto hypothesis = observationTable.generateHypothesis();
         BOOST_LOG_TRIVIAL(debug) << "Hypothesis before simplification\n" << hypothesis;
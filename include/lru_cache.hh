@@ -0,0 +1,177 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace learnta {
+  /*!
+   * @brief Key-value cache with a capacity and the least-recently-used eviction policy
+   *
+   * The entries are kept in a list ordered by the last access, and the index refers to the keys in the list so that each
+   * key is stored only once.
+   *
+   * @tparam Key The type of the keys. It must be hashable by boost::hash.
+   * @tparam Value The type of the values
+   */
+  template<class Key, class Value>
+  class LRUCache {
+  private:
+    using Entry = std::pair<const Key, Value>;
+    using KeyReference = std::reference_wrapper<const Key>;
+
+    struct Hash {
+      std::size_t operator()(const KeyReference &key) const {
+        return boost::hash<Key>{}(key.get());
+      }
+    };
+
+    struct Equal {
+      bool operator()(const KeyReference &left, const KeyReference &right) const {
+        return left.get() == right.get();
+      }
+    };
+
+    //! @brief The maximum number of entries. 0 means unbounded.
+    std::size_t maxSize;
+    //! @brief The entries from the most recently used one
+    std::list<Entry> entries;
+    boost::unordered_map<KeyReference, typename std::list<Entry>::iterator, Hash, Equal> index;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+
+    void evict() {
+      while (maxSize != 0 && entries.size() > maxSize) {
+        index.erase(std::cref(entries.back().first));
+        entries.pop_back();
+        ++evictions;
+      }
+    }
+
+  public:
+    /*!
+     * @param capacity The maximum number of entries. If it is 0, the cache is unbounded.
+     */
+    explicit LRUCache(std::size_t capacity = 0) : maxSize(capacity) {}
+
+    LRUCache(const LRUCache &) = delete;
+    LRUCache &operator=(const LRUCache &) = delete;
+
+    /*!
+     * @brief Find the value of the given key and mark it as the most recently used one
+     *
+     * @returns The pointer to the value, or nullptr if the key is not in the cache. It is valid until the next insertion.
+     */
+    const Value *find(const Key &key) {
+      auto it = index.find(std::cref(key));
+      if (it == index.end()) {
+        ++misses;
+        return nullptr;
+      }
+      ++hits;
+      entries.splice(entries.begin(), entries, it->second);
+      return &it->second->second;
+    }
+
+    /*!
+     * @brief Find the value of a key given by an object of another type without constructing the key
+     *
+     * For example, LRUCache<TimedWordKey, bool> can be looked up by a TimedWord.
+     *
+     * @pre boost::hash<CompatibleKey> is the same as boost::hash<Key> for the equal ones, and Key == CompatibleKey is
+     * defined
+     * @returns The pointer to the value, or nullptr if the key is not in the cache. It is valid until the next insertion.
+     * @note The types implicitly convertible to Key, e.g., string literals for std::string, use the other overload.
+     */
+    template<class CompatibleKey>
+    std::enable_if_t<!std::is_convertible_v<const CompatibleKey &, const Key &>, const Value *>
+    find(const CompatibleKey &key) {
+      struct CompatibleEqual {
+        bool operator()(const CompatibleKey &left, const KeyReference &right) const {
+          return right.get() == left;
+        }
+
+        bool operator()(const KeyReference &left, const CompatibleKey &right) const {
+          return left.get() == right;
+        }
+      };
+      auto it = index.find(key, boost::hash<CompatibleKey>{}, CompatibleEqual{});
+      if (it == index.end()) {
+        ++misses;
+        return nullptr;
+      }
+      ++hits;
+      entries.splice(entries.begin(), entries, it->second);
+      return &it->second->second;
+    }
+
+    /*!
+     * @brief Insert or update the value of the given key and mark it as the most recently used one
+     */
+    void insert(const Key &key, Value value) {
+      auto it = index.find(std::cref(key));
+      if (it != index.end()) {
+        it->second->second = std::move(value);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+      }
+      entries.emplace_front(key, std::move(value));
+      index.emplace(std::cref(entries.front().first), entries.begin());
+      this->evict();
+    }
+
+    //! @brief Change the capacity. The least recently used entries are evicted if necessary.
+    void setCapacity(std::size_t capacity) {
+      maxSize = capacity;
+      this->evict();
+    }
+
+    [[nodiscard]] std::size_t capacity() const {
+      return maxSize;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+      return entries.size();
+    }
+
+    [[nodiscard]] std::size_t countHits() const {
+      return hits;
+    }
+
+    [[nodiscard]] std::size_t countMisses() const {
+      return misses;
+    }
+
+    [[nodiscard]] std::size_t countEvictions() const {
+      return evictions;
+    }
+
+    /*!
+     * @brief Print the statistics of the cache
+     *
+     * @param name The name of the cache used in the output
+     */
+    std::ostream &printStatistics(std::ostream &stream, const std::string &name) const {
+      stream << "Size of " << name << ": " << this->size();
+      if (maxSize != 0) {
+        stream << " / " << maxSize;
+      }
+      stream << "\n";
+      stream << "Number of hits/misses/evictions of " << name << ": "
+             << hits << "/" << misses << "/" << evictions << "\n";
+
+      return stream;
+    }
+  };
+}
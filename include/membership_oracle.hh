@@ -5,10 +5,15 @@
 
 #pragma once
 #include <memory>
+#include <variant>
+#include <vector>
 #include <boost/unordered_map.hpp>
 
 #include "sul.hh"
 #include "timed_word.hh"
+#include "timed_word_key.hh"
+#include "prefix_trie_scheduler.hh"
+#include "lru_cache.hh"
 
 namespace learnta {
   /*!
@@ -17,6 +22,23 @@ namespace learnta {
   class MembershipOracle {
   public:
     virtual bool answerQuery(const TimedWord &timedWord) = 0;
+
+    /*!
+     * @brief Answer a batch of membership queries
+     *
+     * @returns The vector showing if each of the timed words is in the target language
+     * @note The default implementation answers the queries one by one.
+     */
+    virtual std::vector<bool> answerQueries(const std::vector<TimedWord> &timedWords) {
+      std::vector<bool> result;
+      result.reserve(timedWords.size());
+      for (const auto &timedWord: timedWords) {
+        result.push_back(this->answerQuery(timedWord));
+      }
+
+      return result;
+    }
+
     [[nodiscard]] virtual std::size_t count() const = 0;
     virtual ~MembershipOracle() = default;
 
@@ -29,51 +51,171 @@ namespace learnta {
 
   /*!
    * @brief Membership oracle defined by an SUL
+   *
+   * We remember the prefixes leading the SUL to a rejecting sink, and reject any timed word with such a prefix without
+   * executing the SUL. Such a timed word is still counted in count() via SUL::countSharedQueries. The memory for the
+   * prefixes is bounded by SinkPrefixTrie::defaultCapacity.
    */
   class SULMembershipOracle final : public MembershipOracle {
   private:
     std::unique_ptr<SUL> sul;
+    SinkPrefixTrie sinkPrefixes;
+    PrefixTrieScheduler::Statistics statistics;
   public:
     explicit SULMembershipOracle(std::unique_ptr<SUL> &&sul) : sul(std::move(sul)) {}
 
+    /*!
+     * @brief Feed a single timed word directly without constructing a prefix trie
+     */
     bool answerQuery(const learnta::TimedWord &timedWord) override {
+      if (sinkPrefixes.rejects(timedWord)) {
+        sul->countSharedQueries(1);
+        return false;
+      }
       sul->pre();
-      std::string word = timedWord.getWord();
-      std::vector<double> duration = timedWord.getDurations();
-      bool result = sul->step(duration[0]);
-      for (std::size_t i = 0; i < timedWord.wordSize(); i++) {
-        sul->step(word[i]);
-        result = sul->step(duration[i + 1]);
+      ++statistics.executions;
+      bool result = false;
+      const std::size_t n = numSteps(timedWord);
+      for (std::size_t i = 0; i < n; ++i) {
+        result = std::visit([&](auto value) {
+          return sul->step(value);
+        }, nthStep(timedWord, i));
+        ++statistics.steps;
+        if (sul->inRejectingSink()) {
+          sinkPrefixes.add(timedWord, i + 1);
+          result = false;
+          break;
+        }
       }
       sul->post();
 
       return result;
     }
 
+    /*!
+     * @brief Answer a batch of membership queries sharing the execution of their common prefixes if possible
+     *
+     * @sa PrefixTrieScheduler
+     */
+    std::vector<bool> answerQueries(const std::vector<TimedWord> &timedWords) override {
+      std::vector<std::size_t> toExecuteIndices;
+      for (std::size_t i = 0; i < timedWords.size(); ++i) {
+        if (!sinkPrefixes.rejects(timedWords.at(i))) {
+          toExecuteIndices.push_back(i);
+        }
+      }
+      if (toExecuteIndices.size() == timedWords.size()) {
+        return PrefixTrieScheduler::execute(*sul, timedWords, &sinkPrefixes, &statistics);
+      }
+      sul->countSharedQueries(timedWords.size() - toExecuteIndices.size());
+      std::vector<TimedWord> toExecute;
+      toExecute.reserve(toExecuteIndices.size());
+      for (const std::size_t index: toExecuteIndices) {
+        toExecute.push_back(timedWords.at(index));
+      }
+      std::vector<bool> result(timedWords.size(), false);
+      const auto executed = PrefixTrieScheduler::execute(*sul, toExecute, &sinkPrefixes, &statistics);
+      for (std::size_t i = 0; i < toExecute.size(); ++i) {
+        result.at(toExecuteIndices.at(i)) = executed.at(i);
+      }
+
+      return result;
+    }
+
     [[nodiscard]] size_t count() const override {
       return this->sul->count();
     }
+
+    /*!
+     * @brief Print the executions of the SUL and the steps fed to it
+     *
+     * The number of the membership queries is printed by the wrapping MembershipOracleCache.
+     */
+    std::ostream &printStatistics(std::ostream &stream) const override {
+      stream << "Number of SUL executions: " << statistics.executions << "\n";
+      stream << "Number of SUL steps: " << statistics.steps << "\n";
+
+      return stream;
+    }
   };
 
   /*!
    * @brief Wrapper of a membership oracle to cache the result
+   *
+   * When the number of the cached results exceeds the capacity, the least recently used one is evicted.
    */
   class MembershipOracleCache final : public MembershipOracle {
     std::unique_ptr<MembershipOracle> oracle;
-    boost::unordered_map<TimedWord, bool> membershipCache;
+    LRUCache<TimedWordKey, bool> membershipCache;
     std::size_t countNoCache = 0;
 
   public:
-    explicit MembershipOracleCache(std::unique_ptr<MembershipOracle> &&oracle) : oracle(std::move(oracle)) {}
+    /*!
+     * @param capacity The maximum number of the cached results. If it is 0, the cache is unbounded.
+     */
+    explicit MembershipOracleCache(std::unique_ptr<MembershipOracle> &&oracle, std::size_t capacity = 0) :
+            oracle(std::move(oracle)), membershipCache(capacity) {}
+
+    /*!
+     * @brief Replace the wrapped oracle with the given function applied to it, e.g., to add a layer below the cache
+     *
+     * @pre The new oracle answers the same as the current one
+     */
+    template<class Wrap>
+    void wrapOracle(Wrap wrap) {
+      this->oracle = wrap(std::move(this->oracle));
+    }
 
     bool answerQuery(const TimedWord &timedWord) override {
       ++countNoCache;
-      auto it = this->membershipCache.find(timedWord);
-      if (it != membershipCache.end()) {
-        return it->second;
+      if (const bool *cached = this->membershipCache.find(timedWord)) {
+        return *cached;
       }
       const auto result = this->oracle->answerQuery(timedWord);
-      this->membershipCache[timedWord] = result;
+      this->membershipCache.insert(TimedWordKey{timedWord}, result);
+
+      return result;
+    }
+
+    /*!
+     * @brief Answer a batch of membership queries
+     *
+     * Only the timed words not in the cache are passed to the wrapped oracle, as a single batch without duplication.
+     */
+    std::vector<bool> answerQueries(const std::vector<TimedWord> &timedWords) override {
+      countNoCache += timedWords.size();
+      std::vector<bool> result(timedWords.size());
+      std::vector<TimedWord> missed;
+      std::vector<TimedWordKey> missedKeys;
+      // The indices in timedWords of each of the missed timed words
+      boost::unordered_map<TimedWordKey, std::vector<std::size_t>> missedIndices;
+      for (std::size_t i = 0; i < timedWords.size(); ++i) {
+        // We construct the key only for the timed words not in the cache
+        if (const bool *cached = this->membershipCache.find(timedWords.at(i))) {
+          result.at(i) = *cached;
+          continue;
+        }
+        TimedWordKey key{timedWords.at(i)};
+        auto missedIt = missedIndices.find(key);
+        if (missedIt == missedIndices.end()) {
+          missed.push_back(timedWords.at(i));
+          missedIndices.emplace(key, std::vector<std::size_t>{i});
+          missedKeys.push_back(std::move(key));
+        } else {
+          missedIt->second.push_back(i);
+        }
+      }
+      if (missed.empty()) {
+        return result;
+      }
+      const auto missedResult = this->oracle->answerQueries(missed);
+      assert(missedResult.size() == missed.size());
+      for (std::size_t i = 0; i < missed.size(); ++i) {
+        this->membershipCache.insert(missedKeys.at(i), missedResult.at(i));
+        for (const std::size_t index: missedIndices.at(missedKeys.at(i))) {
+          result.at(index) = missedResult.at(i);
+        }
+      }
 
       return result;
     }
@@ -85,8 +227,9 @@ namespace learnta {
     std::ostream &printStatistics(std::ostream &stream) const override {
       stream << "Number of membership queries: " << countNoCache << "\n";
       stream << "Number of membership queries (with cache): " << this->count() << "\n";
+      this->membershipCache.printStatistics(stream, "membership query cache");
 
-      return stream;
+      return this->oracle->printStatistics(stream);
     }
   };
 }
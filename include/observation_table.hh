@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <stack>
@@ -12,6 +13,7 @@
 #include <queue>
 #include <unordered_map>
 
+#include <boost/functional/hash.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/log/trivial.hpp>
@@ -29,6 +31,10 @@
 #include "counterexample_analyzer.hh"
 #include "neighbor_conditions.hh"
 #include "imprecise_clock_handler.hh"
+#include "table_storage.hh"
+#include "triangular_bit_matrix.hh"
+#include "column_order.hh"
+#include "binary_serialization.hh"
 
 #ifdef PRINT_REFINEMENT_INFO
 #define LOG_REFINEMENT_INFO BOOST_LOG_TRIVIAL(info)
@@ -46,19 +52,34 @@ namespace learnta {
     std::vector<Alphabet> alphabet;
     std::vector<ForwardRegionalElementaryLanguage> prefixes;
     std::vector<BackwardRegionalElementaryLanguage> suffixes;
-    // concatenations.at(i).at(j) = prefixes.at(i).getTimedCondition() + suffixes.at(j).getTimedCondition()
-    std::vector<std::vector<TimedCondition>> concatenations;
+    // concatenations.at(i, j) = prefixes.at(i).getTimedCondition() + suffixes.at(j).getTimedCondition()
+    TableStorage<TimedCondition> concatenations;
     // The indexes of prefixes in P
     std::unordered_set<std::size_t> pIndices;
-    // prefixes[first] and prefixes[second.first] are in the same equivalence class witnessed by second.second
-    // Maybe we should use vector instead
-    std::unordered_map<std::size_t, std::unordered_map<std::size_t, RenamingRelation>> closedRelation;
+    // prefixes[i] and prefixes[first] are in the same equivalence class witnessed by second for each element of
+    // closedRelation.at(i). It has an element for each prefix. The witness is chosen in the iteration order of the
+    // unordered_map, so changing its type may change the hypotheses.
+    std::vector<std::unordered_map<std::size_t, RenamingRelation>> closedRelation;
     // The table containing the symbolic membership
-    std::vector<std::vector<TimedConditionSet>> table;
+    TableStorage<TimedConditionSet> table;
+    // statuses.at(i, j) = decideStatus(concatenations.at(i, j), table.at(i, j))
+    TableStorage<CellStatus> statuses;
+    // The hash value of each row of statuses. Rows with different statuses are never equivalent.
+    std::vector<std::size_t> signatures;
     std::unordered_map<std::size_t, std::size_t> continuousSuccessors;
     boost::unordered_map<std::pair<std::size_t, Alphabet>, std::size_t> discreteSuccessors;
     // The pair of prefixes such that we know that they are distinguished
-    boost::unordered_set<std::pair<std::size_t, std::size_t>> distinguishedPrefix;
+    TriangularBitMatrix distinguishedPrefix;
+    // The thread pool to fill the new cells of the table and to check the equivalence of the rows
+    ThreadPool pool;
+    // The order to check the columns in the equivalence checks. It changes only the efficiency.
+    mutable ColumnOrder columnOrder;
+    // The magic number at the beginning of the checkpoints
+    static constexpr const char *checkpointMagic = "LTAOTv02";
+    // The pairs (i, j) of P with i > j such that we know they do not cause inconsistency with the current suffixes
+    boost::unordered_set<std::pair<std::size_t, std::size_t>> consistentPairs;
+    // The indices p in P such that we know succ^t(p) does not make the table time-unsaturated with the current suffixes
+    std::unordered_set<std::size_t> timeSaturatedP;
 
     /*!
      * @brief Fill the observation table
@@ -66,18 +87,66 @@ namespace learnta {
      * @post The observation table is filled
      */
     void refreshTable() {
-      table.resize(prefixes.size());
-      concatenations.resize(prefixes.size());
+      // The cells to fill in the row-major order. The rows are added only at the bottom and the columns are added only
+      // at the right.
+      std::vector<std::pair<std::size_t, std::size_t>> newCells;
+      const auto originalRows = table.rows();
+      const auto originalColumns = table.columns();
       for (std::size_t prefixIndex = 0; prefixIndex < prefixes.size(); ++prefixIndex) {
-        const auto originalSize = table.at(prefixIndex).size();
-        table.at(prefixIndex).resize(suffixes.size());
-        concatenations.at(prefixIndex).resize(suffixes.size());
+        const auto originalSize = prefixIndex < originalRows ? originalColumns : 0;
         for (auto suffixIndex = originalSize; suffixIndex < suffixes.size(); ++suffixIndex) {
-          const auto concatenation = prefixes.at(prefixIndex) + suffixes.at(suffixIndex);
-          table.at(prefixIndex).at(suffixIndex) = this->memOracle->query(concatenation);
-          concatenations.at(prefixIndex).at(suffixIndex) = concatenation.getTimedCondition();
+          newCells.emplace_back(prefixIndex, suffixIndex);
         }
       }
+      if (suffixes.size() != originalColumns) {
+        // A new suffix may make equivalent rows inequivalent. The verified results are no longer valid.
+        consistentPairs.clear();
+        timeSaturatedP.clear();
+        equivalentWithColumnCache.clear();
+      }
+      table.resize(prefixes.size(), suffixes.size());
+      concatenations.resize(prefixes.size(), suffixes.size());
+      statuses.resize(prefixes.size(), suffixes.size());
+      signatures.resize(prefixes.size());
+      closedRelation.resize(prefixes.size());
+      if (newCells.empty()) {
+        return;
+      }
+      std::vector<ElementaryLanguage> newConcatenations(newCells.size());
+      pool.parallelFor(newCells.size(), [&](std::size_t i, std::size_t) {
+        newConcatenations.at(i) = prefixes.at(newCells.at(i).first) + suffixes.at(newCells.at(i).second);
+      });
+      auto results = this->memOracle->queries(newConcatenations, &pool);
+      for (std::size_t i = 0; i < newCells.size(); ++i) {
+        const auto [prefixIndex, suffixIndex] = newCells.at(i);
+        table.at(prefixIndex, suffixIndex) = std::move(results.at(i));
+        concatenations.at(prefixIndex, suffixIndex) = newConcatenations.at(i).getTimedCondition();
+        // The new cells of each row are in the ascending order of the suffixes
+        this->updateStatus(prefixIndex, suffixIndex);
+      }
+    }
+
+    /*!
+     * @brief Compute the status of the cell and update the signature of the row
+     *
+     * @pre The cells of the row are given in the ascending order of the suffixes
+     */
+    void updateStatus(std::size_t prefixIndex, std::size_t suffixIndex) {
+      statuses.at(prefixIndex, suffixIndex) = decideStatus(concatenations.at(prefixIndex, suffixIndex),
+                                                           table.at(prefixIndex, suffixIndex));
+      boost::hash_combine(signatures.at(prefixIndex), static_cast<int>(statuses.at(prefixIndex, suffixIndex)));
+    }
+
+    /*!
+     * @brief Returns if the rows have the same status for each suffix, which is necessary for their equivalence
+     */
+    [[nodiscard]] bool sameSignature(std::size_t i, std::size_t j) const {
+      if (signatures.at(i) != signatures.at(j)) {
+        return false;
+      }
+      const auto left = statuses.row(i);
+      const auto right = statuses.row(j);
+      return std::equal(left.begin(), left.end(), right.begin(), right.end());
     }
 
     /*!
@@ -128,87 +197,207 @@ namespace learnta {
     }
 
     std::optional<RenamingRelation> equivalent(std::size_t i, std::size_t j) {
-      auto renamingRelation = findDeterministicEquivalentRenaming(this->prefixes.at(i), this->table.at(i), this->concatenations.at(i),
-                                                                  this->prefixes.at(j), this->table.at(j), this->concatenations.at(j),
-                                                                  this->suffixes);
+      if (!this->sameSignature(i, j)) {
+        this->distinguishedPrefix.insert(i, j);
+        return std::nullopt;
+      }
+      auto renamingRelation = findDeterministicEquivalentRenaming(this->prefixes.at(i), this->table.row(i), this->concatenations.row(i),
+                                                                  this->prefixes.at(j), this->table.row(j), this->concatenations.row(j),
+                                                                  this->suffixes, &pool, &columnOrder);
       if (renamingRelation) {
-        this->closedRelation[i][j] = renamingRelation.value();
+        this->closedRelation.at(i)[j] = renamingRelation.value();
         return renamingRelation;
       } else {
-        this->distinguishedPrefix.insert(std::make_pair(i, j));
+        this->distinguishedPrefix.insert(i, j);
         return std::nullopt;
       }
     }
 
     std::optional<RenamingRelation> equivalentWithMemo(std::size_t i, std::size_t j) {
 #if 1
-      if (this->distinguishedPrefix.find(std::make_pair(i, j)) != this->distinguishedPrefix.end() ||
-          this->distinguishedPrefix.find(std::make_pair(j, i)) != this->distinguishedPrefix.end()) {
+      if (this->distinguishedPrefix.contains(i, j)) {
         // we already know that they are not equivalent
         assert(!this->equivalent(i, j));
         return std::nullopt;
       }
 #endif
-      auto equivalentPrefixesIT = this->closedRelation.find(i);
-      if (equivalentPrefixesIT != this->closedRelation.end()) {
-        auto it = equivalentPrefixesIT->second.find(j);
-        if (it != this->closedRelation.at(i).end()) {
-          if (equivalence(this->prefixes.at(i), this->table.at(i), this->concatenations.at(i),
-                          this->prefixes.at(j), this->table.at(j), this->concatenations.at(j),
-                          this->suffixes, it->second)) {
-            return it->second;
-          }
+      auto it = this->closedRelation.at(i).find(j);
+      if (it != this->closedRelation.at(i).end()) {
+        if (equivalence(this->prefixes.at(i), this->table.row(i), this->concatenations.row(i),
+                        this->prefixes.at(j), this->table.row(j), this->concatenations.row(j),
+                        this->suffixes, it->second)) {
+          return it->second;
         }
       }
       return this->equivalent(i, j);
     }
 
-    boost::unordered_map<std::tuple<std::size_t, std::size_t, BackwardRegionalElementaryLanguage>, std::pair<std::size_t, bool>> equivalentWithColumnCache;
+    //! @brief The action in the key of equivalentWithColumnCache representing the continuous predecessor
+    static constexpr int continuousPredecessor = -1;
+    /*!
+     * @brief The cache of equivalentWithPredecessor
+     *
+     * The key is (i, j, the index of the suffix, the action or continuousPredecessor). The entries are valid only for the
+     * current suffixes, and refreshTable drops all of them when a suffix is added.
+     */
+    boost::unordered_map<std::tuple<std::size_t, std::size_t, std::size_t, int>, bool> equivalentWithColumnCache;
+    //! @brief The maximum size of equivalentWithColumnCache for the statistics
+    std::size_t maxEquivalentWithColumnCacheSize = 0;
 
     /*!
-     * @brief Check if the given rows remain equivalent with a new suffix
+     * @brief Check if the given rows remain equivalent with a predecessor of a suffix as a new suffix
+     *
+     * @param suffixIndex The index of the suffix whose predecessor is the new suffix
+     * @param action The action of the discrete predecessor, or continuousPredecessor for the continuous predecessor
      */
-    [[nodiscard]] bool equivalent(std::size_t i, std::size_t j, const BackwardRegionalElementaryLanguage &newSuffix) {
-      // First, we use the cache
-      auto key = std::make_tuple(i, j, newSuffix);
-      {
-        auto it = equivalentWithColumnCache.find(key);
-        if (it != equivalentWithColumnCache.end() && this->suffixes.size() == it->second.first) {
-          return it->second.second;
+    [[nodiscard]] bool equivalentWithPredecessor(std::size_t i, std::size_t j, std::size_t suffixIndex, int action) {
+      const auto key = std::make_tuple(i, j, suffixIndex, action);
+      auto it = equivalentWithColumnCache.find(key);
+      if (it != equivalentWithColumnCache.end()) {
+        return it->second;
+      }
+      const auto &suffix = this->suffixes.at(suffixIndex);
+      const bool result = equivalent(i, j, action == continuousPredecessor ? suffix.predecessor() :
+                                           suffix.predecessor(static_cast<Alphabet>(action)));
+      equivalentWithColumnCache.emplace(key, result);
+      maxEquivalentWithColumnCacheSize = std::max(maxEquivalentWithColumnCacheSize, equivalentWithColumnCache.size());
+
+      return result;
+    }
+
+    //! @brief The number of the suffixes removed by minimizeSuffixes for the statistics
+    std::size_t numRemovedSuffixes = 0;
+    /*!
+     * @brief necessarySuffixes.at(i) is true if we know that removing suffixes.at(i) changes the equivalence of rows
+     *
+     * Since adding rows does not make a necessary suffix redundant, we check each suffix at most once until it becomes
+     * redundant.
+     */
+    std::vector<bool> necessarySuffixes;
+
+    /*!
+     * @brief Returns the renaming witnessing the equivalence of the rows without the given suffix, if any
+     */
+    [[nodiscard]] std::optional<RenamingRelation> equivalentWithoutSuffix(std::size_t i, std::size_t j,
+                                                                          std::size_t suffixIndex) {
+      const auto without = [suffixIndex](auto row) {
+        auto result = row.toVector();
+        result.erase(result.begin() + static_cast<std::ptrdiff_t>(suffixIndex));
+        return result;
+      };
+      auto reducedSuffixes = this->suffixes;
+      reducedSuffixes.erase(reducedSuffixes.begin() + static_cast<std::ptrdiff_t>(suffixIndex));
+      return findDeterministicEquivalentRenaming(this->prefixes.at(i), without(this->table.row(i)),
+                                                 without(this->concatenations.row(i)),
+                                                 this->prefixes.at(j), without(this->table.row(j)),
+                                                 without(this->concatenations.row(j)),
+                                                 reducedSuffixes, &pool);
+    }
+
+    /*!
+     * @brief Returns if removing the suffix does not make any pair of inequivalent rows equivalent
+     *
+     * Since removing a suffix only removes conditions of the equivalence, the equivalent rows remain equivalent, and
+     * their renaming witnesses remain valid. Therefore, we only check the inequivalent rows.
+     *
+     * @param witnesses The memo of the witnesses with all the suffixes
+     */
+    [[nodiscard]] bool redundantSuffix(
+            std::size_t suffixIndex,
+            boost::unordered_map<std::pair<std::size_t, std::size_t>, std::optional<RenamingRelation>> &witnesses) {
+      // The pairs of the rows with the same statuses except for the suffix. The other pairs remain distinguished.
+      std::vector<std::pair<std::size_t, std::size_t>> sameStatusPairs, differentStatusPairs;
+      for (std::size_t i = 0; i < this->prefixes.size(); ++i) {
+        for (std::size_t j = i + 1; j < this->prefixes.size(); ++j) {
+          bool sameStatusOutside = true;
+          for (std::size_t column = 0; column < this->suffixes.size() && sameStatusOutside; ++column) {
+            sameStatusOutside = column == suffixIndex || this->statuses.at(i, column) == this->statuses.at(j, column);
+          }
+          if (sameStatusOutside) {
+            if (this->statuses.at(i, suffixIndex) == this->statuses.at(j, suffixIndex)) {
+              sameStatusPairs.emplace_back(i, j);
+            } else {
+              differentStatusPairs.emplace_back(i, j);
+            }
+          }
+        }
+      }
+      // The pairs distinguished only by the status of the suffix are the most likely to become equivalent
+      for (const auto &[i, j]: differentStatusPairs) {
+        if (this->equivalentWithoutSuffix(i, j, suffixIndex)) {
+          return false;
+        }
+      }
+      for (const auto &[i, j]: sameStatusPairs) {
+        auto it = witnesses.find(std::make_pair(i, j));
+        if (it == witnesses.end()) {
+          it = witnesses.emplace(std::make_pair(i, j), findDeterministicEquivalentRenaming(
+                  this->prefixes.at(i), this->table.row(i), this->concatenations.row(i),
+                  this->prefixes.at(j), this->table.row(j), this->concatenations.row(j),
+                  this->suffixes, &pool, &columnOrder)).first;
+        }
+        if (!it->second && this->equivalentWithoutSuffix(i, j, suffixIndex)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /*!
+     * @brief Remove the column of the given suffix
+     *
+     * @pre The suffix is redundant, i.e., removing it does not change the equivalence of the rows
+     */
+    void eraseSuffix(std::size_t suffixIndex) {
+      this->suffixes.erase(this->suffixes.begin() + static_cast<std::ptrdiff_t>(suffixIndex));
+      this->table.eraseColumn(suffixIndex);
+      this->concatenations.eraseColumn(suffixIndex);
+      this->statuses.eraseColumn(suffixIndex);
+      this->necessarySuffixes.erase(this->necessarySuffixes.begin() + static_cast<std::ptrdiff_t>(suffixIndex));
+      for (std::size_t i = 0; i < this->prefixes.size(); ++i) {
+        this->signatures.at(i) = 0;
+        for (const auto status: this->statuses.row(i)) {
+          boost::hash_combine(this->signatures.at(i), static_cast<int>(status));
         }
       }
-      // Then, we try the known renaming relations
+      // distinguishedPrefix and closedRelation remain valid because the equivalence of the rows does not change. The
+      // other memos are for the current suffixes or refer to them by the index.
+      this->consistentPairs.clear();
+      this->timeSaturatedP.clear();
+      this->equivalentWithColumnCache.clear();
+      this->columnOrder.clear();
+      ++this->numRemovedSuffixes;
+    }
+
+    /*!
+     * @brief Check if the given rows remain equivalent with a new suffix
+     */
+    [[nodiscard]] bool equivalent(std::size_t i, std::size_t j, const BackwardRegionalElementaryLanguage &newSuffix) {
+      // First, we try the known renaming relations
       {
-        auto equivalentPrefixesIT = this->closedRelation.find(i);
-        if (equivalentPrefixesIT != this->closedRelation.end()) {
-          auto it = equivalentPrefixesIT->second.find(j);
-          if (it != this->closedRelation.at(i).end()) {
-            if (equivalent(i, j, newSuffix, it->second)) {
-              equivalentWithColumnCache[key] = std::make_pair(this->suffixes.size(), true);
-              return true;
-            }
+        auto it = this->closedRelation.at(i).find(j);
+        if (it != this->closedRelation.at(i).end()) {
+          if (equivalent(i, j, newSuffix, it->second)) {
+            return true;
           }
         }
       }
       // Finally, we try to find an equivalent renaming
-      auto leftRow = this->table.at(i);
-      auto leftConcatenations = this->concatenations.at(i);
+      auto leftRow = this->table.row(i).toVector();
+      auto leftConcatenations = this->concatenations.row(i).toVector();
       const auto newLeftConcatenation = prefixes.at(i) + newSuffix;
       leftRow.emplace_back(this->memOracle->query(newLeftConcatenation));
       leftConcatenations.emplace_back(newLeftConcatenation.getTimedCondition());
-      auto rightRow = this->table.at(j);
-      auto rightConcatenations = this->concatenations.at(j);
+      auto rightRow = this->table.row(j).toVector();
+      auto rightConcatenations = this->concatenations.row(j).toVector();
       const auto newRightConcatenation = prefixes.at(j) + newSuffix;
       rightRow.emplace_back(this->memOracle->query(newRightConcatenation));
       rightConcatenations.emplace_back(newRightConcatenation.getTimedCondition());
       auto newSuffixes = this->suffixes;
       newSuffixes.emplace_back(newSuffix);
-      const auto result = findDeterministicEquivalentRenaming(this->prefixes.at(i), leftRow, leftConcatenations,
-                                                              this->prefixes.at(j), rightRow, rightConcatenations,
-                                                              newSuffixes).has_value();
-      equivalentWithColumnCache[key] = std::make_pair(this->suffixes.size(), result);
-
-      return result;
+      return findDeterministicEquivalentRenaming(this->prefixes.at(i), leftRow, leftConcatenations,
+                                                 this->prefixes.at(j), rightRow, rightConcatenations,
+                                                 newSuffixes, &pool, &columnOrder).has_value();
     }
 
     /*!
@@ -217,14 +406,14 @@ namespace learnta {
     [[nodiscard]] bool equivalent(std::size_t i, std::size_t j, const BackwardRegionalElementaryLanguage &newSuffix,
                                   const RenamingRelation &renaming) const {
       const auto leftPrefix = this->prefixes.at(i);
-      auto leftRow = this->table.at(i);
-      auto leftConcatenation = this->concatenations.at(i);
+      auto leftRow = this->table.row(i).toVector();
+      auto leftConcatenation = this->concatenations.row(i).toVector();
       auto newLeftConcatenation = prefixes.at(i) + newSuffix;
       leftRow.emplace_back(this->memOracle->query(newLeftConcatenation));
       leftConcatenation.emplace_back(newLeftConcatenation.getTimedCondition());
       const auto rightPrefix = this->prefixes.at(j);
-      auto rightRow = this->table.at(j);
-      auto rightConcatenation = this->concatenations.at(j);
+      auto rightRow = this->table.row(j).toVector();
+      auto rightConcatenation = this->concatenations.row(j).toVector();
       auto newRightConcatenation = prefixes.at(j) + newSuffix;
       rightRow.emplace_back(this->memOracle->query(newRightConcatenation));
       rightConcatenation.emplace_back(newRightConcatenation.getTimedCondition());
@@ -233,15 +422,15 @@ namespace learnta {
 
       return equivalence(leftPrefix, leftRow, leftConcatenation,
                          rightPrefix, rightRow, rightConcatenation,
-                         newSuffixes, renaming);
+                         newSuffixes, renaming, nullptr, &columnOrder);
     }
 
 #if 0
     [[nodiscard]] bool
     equivalent(std::size_t i, std::size_t j, const std::list<BackwardRegionalElementaryLanguage> &newSuffixes) const {
-      auto leftRow = this->table.at(i);
+      auto leftRow = this->table.row(i).toVector();
       leftRow.reserve(leftRow.size() + newSuffixes.size());
-      auto rightRow = this->table.at(j);
+      auto rightRow = this->table.row(j).toVector();
       rightRow.reserve(rightRow.size() + newSuffixes.size());
       auto tmpSuffixes = this->suffixes;
       tmpSuffixes.reserve(tmpSuffixes.size() + newSuffixes.size());
@@ -261,7 +450,7 @@ namespace learnta {
      * @brief Returns if row[i] is accepting or not
      */
     [[nodiscard]] bool isMatch(std::size_t i) const {
-      return !this->table.at(i).at(0).empty();
+      return !this->table.at(i, 0).empty();
     }
 
     /*!
@@ -298,12 +487,17 @@ namespace learnta {
   public:
     /*!
      * @brief Initialize the observation table
+     *
+     * @param numThreads The number of threads to fill the new cells of the table. If it is 0, we use the number of the
+     * hardware threads.
      */
-    ObservationTable(std::vector<Alphabet> alphabet, std::unique_ptr<SymbolicMembershipOracle> memOracle) :
+    ObservationTable(std::vector<Alphabet> alphabet, std::unique_ptr<SymbolicMembershipOracle> memOracle,
+                     std::size_t numThreads = 1) :
             memOracle(std::move(memOracle)),
             alphabet(std::move(alphabet)),
             prefixes{ForwardRegionalElementaryLanguage{}},
-            suffixes{BackwardRegionalElementaryLanguage{}} {
+            suffixes{BackwardRegionalElementaryLanguage{}},
+            pool(numThreads) {
       this->moveToP(0);
       this->refreshTable();
     }
@@ -316,47 +510,53 @@ namespace learnta {
      * @returns returns true if the observation table is already closed
      */
     bool close() {
+      // The rows in P indexed by their signatures. The order in each bucket follows the iteration order of pIndices.
+      boost::unordered_map<std::size_t, std::vector<std::size_t>> pIndicesBySignature;
+      for (const auto j: this->pIndices) {
+        pIndicesBySignature[this->signatures.at(j)].push_back(j);
+      }
       for (std::size_t i = 0; i < this->prefixes.size(); i++) {
         // Skip if this prefix is in P
         if (this->inP(i)) {
           continue;
         }
         auto prefix = this->prefixes.at(i);
-        auto prefixRow = this->table.at(i);
+        const auto prefixRow = this->table.row(i);
 
         // Use the memoized information for efficiency
         bool found = false;
         {
-          auto it = this->closedRelation.find(i);
-          if (it != closedRelation.end()) {
-            // When we already know that this prefix is equivalent to one of p \in P, we just confirm it.
-            for (auto targetIt = it->second.begin(); targetIt != it->second.end();) {
-              auto renamingRelation = targetIt->second;
-              if (equivalence(prefix, prefixRow, this->concatenations.at(i),
-                              this->prefixes.at(targetIt->first), this->table.at(targetIt->first),
-                              this->concatenations.at(targetIt->first),
-                              this->suffixes, renamingRelation)) {
-                if (this->inP(targetIt->first)) {
-                  found = true;
-                  break;
-                } else {
-                  ++targetIt;
-                }
+          auto &mapping = this->closedRelation.at(i);
+          // When we already know that this prefix is equivalent to one of p \in P, we just confirm it.
+          for (auto targetIt = mapping.begin(); targetIt != mapping.end();) {
+            auto renamingRelation = targetIt->second;
+            if (equivalence(prefix, prefixRow, this->concatenations.row(i),
+                            this->prefixes.at(targetIt->first), this->table.row(targetIt->first),
+                            this->concatenations.row(targetIt->first),
+                            this->suffixes, renamingRelation)) {
+              if (this->inP(targetIt->first)) {
+                found = true;
+                break;
               } else {
-                targetIt = it->second.erase(targetIt);
+                ++targetIt;
               }
+            } else {
+              targetIt = mapping.erase(targetIt);
             }
           }
         }
 
-        // We have no idea of the target prefix, and we find an equivalent row
-        if (!found) {
+        // We have no idea of the target prefix, and we find an equivalent row. We only try the rows in P with the same
+        // signature because the others are never equivalent.
+        auto candidatesIt = pIndicesBySignature.find(this->signatures.at(i));
+        if (!found && candidatesIt != pIndicesBySignature.end()) {
+          const auto &candidates = candidatesIt->second;
           // First, we try to "jump" to the same state
-          found = std::any_of(this->pIndices.begin(), this->pIndices.end(), [&](const auto j) {
+          found = std::any_of(candidates.begin(), candidates.end(), [&](const auto j) {
             return this->continuousSuccessors.at(j) == i && equivalentWithMemo(i, j);
           });
           if (!found) {
-            found = std::any_of(this->pIndices.begin(), this->pIndices.end(), [&](const auto j) {
+            found = std::any_of(candidates.begin(), candidates.end(), [&](const auto j) {
               return equivalentWithMemo(i, j);
             });
           }
@@ -424,14 +624,15 @@ namespace learnta {
      */
     void resolveDiscreteInconsistency(std::size_t i, std::size_t j, Alphabet action) {
       // Find a single witness of the inconsistency
-      auto it = std::find_if_not(suffixes.begin(), suffixes.end(), [&](const auto &suffix) {
-        return equivalent(i, j, suffix.predecessor(action));
-      });
+      std::size_t suffixIndex = 0;
+      while (suffixIndex < suffixes.size() && equivalentWithPredecessor(i, j, suffixIndex, action)) {
+        ++suffixIndex;
+      }
       // we assume that we have such a suffix
-      if (it == suffixes.end()) {
+      if (suffixIndex == suffixes.size()) {
         abort();
       }
-      const auto newSuffix = it->predecessor(action);
+      const auto newSuffix = suffixes.at(suffixIndex).predecessor(action);
       LOG_REFINEMENT_INFO << "New suffix " << newSuffix << " is added";
       suffixes.emplace_back(newSuffix);
 
@@ -451,14 +652,15 @@ namespace learnta {
      */
     [[nodiscard]] bool resolveContinuousInconsistency(std::size_t i, std::size_t j) {
       // Find a single witness of the inconsistency
-      auto it = std::find_if_not(suffixes.begin(), suffixes.end(), [&](const auto &suffix) {
-        return equivalent(i, j, suffix.predecessor());
-      });
+      std::size_t suffixIndex = 0;
+      while (suffixIndex < suffixes.size() && equivalentWithPredecessor(i, j, suffixIndex, continuousPredecessor)) {
+        ++suffixIndex;
+      }
       // We may fail to resolve continuous inconsistency
-      if (it == suffixes.end()) {
+      if (suffixIndex == suffixes.size()) {
         return false;
       }
-      const auto newSuffix = it->predecessor();
+      const auto newSuffix = suffixes.at(suffixIndex).predecessor();
       LOG_REFINEMENT_INFO << "New suffix " << newSuffix << " is added";
       suffixes.emplace_back(newSuffix);
 
@@ -497,7 +699,8 @@ namespace learnta {
 
       std::vector<SingleMorphism> morphisms;
       morphisms.reserve(this->closedRelation.size());
-      for (auto &[i, mapping]: this->closedRelation) {
+      for (std::size_t i = 0; i < this->closedRelation.size(); ++i) {
+        auto &mapping = this->closedRelation.at(i);
         if (!this->inP(i) && !mapping.empty()) {
           for (auto it = mapping.begin(); it != mapping.end();) {
             if (this->inP(it->first) && this->equivalentWithMemo(i, it->first)) {
@@ -518,12 +721,14 @@ namespace learnta {
     /*!
      * @brief Make the observation table consistent
      *
+     * Since the cells of the table never change, we skip the pairs already checked with the current suffixes.
+     *
      * @returns true if the observation table is already consistent
      */
     bool consistent() {
       for (const auto i: pIndices) {
         for (const auto j: pIndices) {
-          if (i <= j) {
+          if (i <= j || consistentPairs.find(std::make_pair(i, j)) != consistentPairs.end()) {
             continue;
           }
           if (this->equivalentWithMemo(i, j)) {
@@ -545,6 +750,7 @@ namespace learnta {
               return false;
             }
           }
+          consistentPairs.emplace(i, j);
         }
       }
       return true;
@@ -590,6 +796,9 @@ namespace learnta {
      * Observation table is exterior-saturated if for any \f$p \in P\f$, if \f$\mathrm{succ}^t(p) \not\in P\f$,
      * we have \f$\mathrm{suc}^t(p) \sim^{S, \top} p\f$.
      *
+     * We skip \f$p\f$ already checked with the current suffixes unless the relation of \f$\mathrm{succ}^t(p)\f$ has been
+     * changed since then.
+     *
      * @returns If the observation table is already exterior-saturated
      */
     bool timeSaturate() {
@@ -601,20 +810,28 @@ namespace learnta {
         if (this->inP(successorIndex)) {
           continue;
         }
+        if (timeSaturatedP.find(pIndex) != timeSaturatedP.end()) {
+          // The check below only confirms that succ^t(p) jumps to p without any renaming
+          const auto &mapping = this->closedRelation.at(successorIndex);
+          if (mapping.size() == 1 && mapping.begin()->first == pIndex && mapping.begin()->second.empty()) {
+            continue;
+          }
+        }
         if (equivalentWithMemo(successorIndex, pIndex)) {
-          auto it = this->closedRelation.find(successorIndex);
-          assert(it != this->closedRelation.end());
-          auto it2 = it->second.find(pIndex);
-          assert(it2 != it->second.end());
+          auto &mapping = this->closedRelation.at(successorIndex);
+          auto it2 = mapping.find(pIndex);
+          assert(it2 != mapping.end());
           if (it2->second.empty()) {
             // Modify the cache to jump to pIndex to construct a DTA without unobservable transitions
-            it->second = {*it2};
+            mapping = {*it2};
+            timeSaturatedP.insert(pIndex);
             continue;
-          } else if (equivalence(this->prefixes.at(successorIndex), this->table.at(successorIndex), this->concatenations.at(successorIndex),
-                                 this->prefixes.at(pIndex), this->table.at(pIndex), this->concatenations.at(pIndex),
+          } else if (equivalence(this->prefixes.at(successorIndex), this->table.row(successorIndex), this->concatenations.row(successorIndex),
+                                 this->prefixes.at(pIndex), this->table.row(pIndex), this->concatenations.row(pIndex),
                                  suffixes, RenamingRelation{})) {
-            it->second.clear();
-            it->second[pIndex] = RenamingRelation{};
+            mapping.clear();
+            mapping[pIndex] = RenamingRelation{};
+            timeSaturatedP.insert(pIndex);
             continue;
           }
         }
@@ -636,7 +853,8 @@ namespace learnta {
     }
 
     bool renameConsistent() {
-      for (auto &[i, mapping]: this->closedRelation) {
+      for (std::size_t i = 0; i < this->closedRelation.size(); ++i) {
+        auto &mapping = this->closedRelation.at(i);
         if (!this->inP(i) && !mapping.empty()) {
           for (auto it = mapping.begin(); it != mapping.end();) {
             if (this->inP(it->first) && this->equivalentWithMemo(i, it->first)) {
@@ -711,6 +929,41 @@ namespace learnta {
       return true;
     }
 
+    /*!
+     * @brief Remove the suffixes that do not change the equivalence of any pair of rows
+     *
+     * A suffix is removed only if, for each pair of rows, the rows are equivalent without it if and only if they are
+     * equivalent with it. The known renaming witnesses remain valid, and the hypothesis does not change, while the later
+     * refreshTable and equivalence checks become cheaper. The first suffix is never removed because it decides the
+     * acceptance of each row.
+     *
+     * @note The witnesses found after the removal are searched without the removed suffixes. They may differ from the
+     * ones we would find with all the suffixes, and so may the later hypotheses.
+     * @note For each suffix, we may search for the renaming witnesses of \f$O(|P|^2)\f$ pairs of rows.
+     *
+     * @returns The number of the removed suffixes
+     */
+    std::size_t minimizeSuffixes() {
+      // The witnesses with all the suffixes. Since the removal of a redundant suffix does not change them, we can reuse
+      // them after the removal.
+      boost::unordered_map<std::pair<std::size_t, std::size_t>, std::optional<RenamingRelation>> witnesses;
+      std::size_t removed = 0;
+      this->necessarySuffixes.resize(this->suffixes.size());
+      for (std::size_t suffixIndex = this->suffixes.size() - 1; suffixIndex > 0; --suffixIndex) {
+        if (this->necessarySuffixes.at(suffixIndex)) {
+          continue;
+        }
+        if (this->redundantSuffix(suffixIndex, witnesses)) {
+          LOG_REFINEMENT_INFO << "Suffix " << this->suffixes.at(suffixIndex) << " is removed";
+          this->eraseSuffix(suffixIndex);
+          ++removed;
+        } else {
+          this->necessarySuffixes.at(suffixIndex) = true;
+        }
+      }
+      return removed;
+    }
+
     /*!
      * @brief Refine the suffixes by the given counterexample
      *
@@ -1221,6 +1474,159 @@ namespace learnta {
       return TimedAutomaton{{states, {initialState}}, TimedAutomaton::makeMaxConstants(states)}.simplify();
     }
 
+    /*!
+     * @brief Write the state of the observation table in the binary format
+     *
+     * The header is the magic number, the fingerprint of the target system, and the alphabet. We write the prefixes, the suffixes, the cells, and the relations among the prefixes. The memos only for efficiency,
+     * e.g., distinguishedPrefix, are not written. The unordered containers are written in the ascending order so that
+     * the same table results in the same file.
+     *
+     * @param targetFingerprint The value identifying the target system, e.g., PersistentMembershipOracle::fingerprint
+     * of its description
+     */
+    void save(std::ostream &stream, std::uint64_t targetFingerprint) const {
+      BinaryWriter writer{stream};
+      writer.write(std::string(checkpointMagic));
+      writer.write(targetFingerprint);
+      writer.write(std::string(this->alphabet.begin(), this->alphabet.end()));
+      writer.writeSize(this->prefixes.size());
+      for (const auto &prefix: this->prefixes) {
+        prefix.save(writer);
+      }
+      writer.writeSize(this->suffixes.size());
+      for (const auto &suffix: this->suffixes) {
+        suffix.save(writer);
+      }
+      std::vector<std::size_t> sortedP(this->pIndices.begin(), this->pIndices.end());
+      std::sort(sortedP.begin(), sortedP.end());
+      writer.writeSize(sortedP.size());
+      for (const auto pIndex: sortedP) {
+        writer.writeSize(pIndex);
+      }
+      std::vector<std::pair<std::size_t, std::size_t>> sortedContinuous(this->continuousSuccessors.begin(),
+                                                                         this->continuousSuccessors.end());
+      std::sort(sortedContinuous.begin(), sortedContinuous.end());
+      writer.writeSize(sortedContinuous.size());
+      for (const auto &[source, target]: sortedContinuous) {
+        writer.writeSize(source);
+        writer.writeSize(target);
+      }
+      std::vector<std::pair<std::pair<std::size_t, Alphabet>, std::size_t>> sortedDiscrete(
+              this->discreteSuccessors.begin(), this->discreteSuccessors.end());
+      std::sort(sortedDiscrete.begin(), sortedDiscrete.end());
+      writer.writeSize(sortedDiscrete.size());
+      for (const auto &[source, target]: sortedDiscrete) {
+        writer.writeSize(source.first);
+        writer.write(source.second);
+        writer.writeSize(target);
+      }
+      for (const auto &mapping: this->closedRelation) {
+        std::vector<std::size_t> sortedTargets;
+        sortedTargets.reserve(mapping.size());
+        for (const auto &[target, renaming]: mapping) {
+          sortedTargets.push_back(target);
+        }
+        std::sort(sortedTargets.begin(), sortedTargets.end());
+        writer.writeSize(sortedTargets.size());
+        for (const auto target: sortedTargets) {
+          writer.writeSize(target);
+          mapping.at(target).save(writer);
+        }
+      }
+      for (std::size_t i = 0; i < this->prefixes.size(); ++i) {
+        for (std::size_t j = 0; j < this->suffixes.size(); ++j) {
+          this->table.at(i, j).save(writer);
+          this->concatenations.at(i, j).save(writer);
+        }
+      }
+    }
+
+    /*!
+     * @brief Restore the state of the observation table written by save
+     *
+     * No membership query is made. The memos only for efficiency are reset. The witnesses of each row are inserted in the
+     * ascending order of the target row, so the choice among several witnesses may differ from the saved table.
+     *
+     * @param targetFingerprint The value identifying the target system given to save
+     * @throws std::invalid_argument if the input is not a checkpoint of an observation table with the same target and
+     * alphabet
+     */
+    void load(std::istream &stream, std::uint64_t targetFingerprint) {
+      BinaryReader reader{stream};
+      if (reader.readString() != checkpointMagic) {
+        throw std::invalid_argument("ObservationTable::load: the input is not a checkpoint of an observation table");
+      }
+      if (reader.read<std::uint64_t>() != targetFingerprint) {
+        throw std::invalid_argument("ObservationTable::load: the checkpoint is of another target");
+      }
+      if (reader.readString() != std::string(this->alphabet.begin(), this->alphabet.end())) {
+        throw std::invalid_argument("ObservationTable::load: the alphabet of the checkpoint is different");
+      }
+      std::vector<ForwardRegionalElementaryLanguage> newPrefixes(reader.readSize());
+      for (auto &prefix: newPrefixes) {
+        prefix = ForwardRegionalElementaryLanguage::load(reader);
+      }
+      std::vector<BackwardRegionalElementaryLanguage> newSuffixes(reader.readSize());
+      for (auto &suffix: newSuffixes) {
+        suffix = BackwardRegionalElementaryLanguage::load(reader);
+      }
+      std::unordered_set<std::size_t> newPIndices;
+      for (std::size_t n = reader.readSize(); n > 0; --n) {
+        newPIndices.insert(reader.readSize());
+      }
+      std::unordered_map<std::size_t, std::size_t> newContinuousSuccessors;
+      for (std::size_t n = reader.readSize(); n > 0; --n) {
+        const auto source = reader.readSize();
+        newContinuousSuccessors[source] = reader.readSize();
+      }
+      boost::unordered_map<std::pair<std::size_t, Alphabet>, std::size_t> newDiscreteSuccessors;
+      for (std::size_t n = reader.readSize(); n > 0; --n) {
+        const auto source = reader.readSize();
+        const auto action = reader.read<Alphabet>();
+        newDiscreteSuccessors[std::make_pair(source, action)] = reader.readSize();
+      }
+      std::vector<std::unordered_map<std::size_t, RenamingRelation>> newClosedRelation(newPrefixes.size());
+      for (auto &mapping: newClosedRelation) {
+        for (std::size_t n = reader.readSize(); n > 0; --n) {
+          const auto target = reader.readSize();
+          mapping[target] = RenamingRelation::load(reader);
+        }
+      }
+      TableStorage<TimedConditionSet> newTable;
+      TableStorage<TimedCondition> newConcatenations;
+      newTable.resize(newPrefixes.size(), newSuffixes.size());
+      newConcatenations.resize(newPrefixes.size(), newSuffixes.size());
+      for (std::size_t i = 0; i < newPrefixes.size(); ++i) {
+        for (std::size_t j = 0; j < newSuffixes.size(); ++j) {
+          newTable.at(i, j) = TimedConditionSet::load(reader);
+          newConcatenations.at(i, j) = TimedCondition::load(reader);
+        }
+      }
+
+      // Replace the state only after the whole checkpoint is read
+      this->prefixes = std::move(newPrefixes);
+      this->suffixes = std::move(newSuffixes);
+      this->pIndices = std::move(newPIndices);
+      this->continuousSuccessors = std::move(newContinuousSuccessors);
+      this->discreteSuccessors = std::move(newDiscreteSuccessors);
+      this->closedRelation = std::move(newClosedRelation);
+      this->table = std::move(newTable);
+      this->concatenations = std::move(newConcatenations);
+      this->distinguishedPrefix.clear();
+      this->consistentPairs.clear();
+      this->timeSaturatedP.clear();
+      this->equivalentWithColumnCache.clear();
+      this->necessarySuffixes.clear();
+      this->statuses = TableStorage<CellStatus>{};
+      this->statuses.resize(this->prefixes.size(), this->suffixes.size());
+      this->signatures.assign(this->prefixes.size(), 0);
+      for (std::size_t i = 0; i < this->prefixes.size(); ++i) {
+        for (std::size_t j = 0; j < this->suffixes.size(); ++j) {
+          this->updateStatus(i, j);
+        }
+      }
+    }
+
     std::ostream &printDetail(std::ostream &stream) const {
       printStatistics(stream);
       stream << "P is as follows\n";
@@ -1239,6 +1645,9 @@ namespace learnta {
       stream << "|P| = " << this->pIndices.size() << "\n";
       stream << "|ext(P)| = " << this->prefixes.size() - this->pIndices.size() << "\n";
       stream << "|S| = " << this->suffixes.size() << "\n";
+      stream << "Size of the cache of the equivalence with a new suffix: " << this->equivalentWithColumnCache.size()
+             << " (max: " << this->maxEquivalentWithColumnCacheSize << ")\n";
+      stream << "Number of the removed suffixes: " << this->numRemovedSuffixes << "\n";
 
       return this->memOracle->printStatistics(stream);
     }
@@ -0,0 +1,537 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// bounds.hh must be included before Eigen so that Eigen finds the operators on Bounds
+#include "common_types.hh"
+#include "bounds.hh"
+#include "constraint.hh"
+#include "zone.hh"
+
+#include <Eigen/Core>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LEARNTA_PACKED_ZONE_AVX2
+#endif
+
+namespace learnta {
+  /*!
+   * @brief A bound of a DBM with an integer constant packed in a 32-bit integer
+   *
+   * The bound \f$(c, s)\f$ is encoded as \f$2c + 1\f$ if it is non-strict (\f$\le\f$) and \f$2c\f$ if it is strict
+   * (\f$<\f$), as in the DBM library of UPPAAL. The order of the encoded integers is the same as that of Bounds, and the
+   * sum of two bounds is computed with a few integer operations.
+   */
+  using PackedBounds = std::int32_t;
+
+  //! @brief The packed bound corresponding to Bounds(std::numeric_limits<double>::max(), false)
+  static constexpr PackedBounds packedInfinity = std::numeric_limits<PackedBounds>::max() - 1;
+  /*!
+   * @brief The largest absolute value of the constants we can pack
+   *
+   * A bound of a satisfiable canonical DBM is the sum of the constants along a simple path, i.e., at most
+   * maxPackedDimension - 1 constants. Therefore, the sum of two bounds in the canonization does not overflow if the
+   * constants are at most maxPackedConstant and the dimension is at most maxPackedDimension. For an unsatisfiable DBM,
+   * we stop closing it once a diagonal entry is negative so that the bounds do not keep decreasing.
+   */
+  static constexpr int maxPackedConstant = (1 << 20);
+  //! @brief The largest dimension of the DBMs we can pack. See maxPackedConstant.
+  static constexpr int maxPackedDimension = 512;
+
+  static inline PackedBounds packBounds(int constant, bool nonStrict) {
+    assert(std::abs(constant) <= maxPackedConstant);
+    return static_cast<PackedBounds>(constant * 2 + (nonStrict ? 1 : 0));
+  }
+
+  //! @pre bound represents an integer bound or infinity
+  static inline PackedBounds packBounds(const Bounds &bound) {
+    if (bound.first >= std::numeric_limits<double>::max()) {
+      return packedInfinity;
+    }
+    assert(bound.first == std::floor(bound.first));
+    return packBounds(static_cast<int>(bound.first), bound.second);
+  }
+
+  //! @brief The constant of the bound. We do not rely on the arithmetic shift of negative integers.
+  static inline int packedConstant(PackedBounds bound) {
+    return (bound - (bound & 1)) / 2;
+  }
+
+  static inline Bounds unpackBounds(PackedBounds bound) {
+    if (bound == packedInfinity) {
+      return Bounds{std::numeric_limits<double>::max(), false};
+    }
+    return Bounds{packedConstant(bound), (bound & 1) == 1};
+  }
+
+  //! @brief The sum of two bounds. The sum with infinity is infinity.
+  static inline PackedBounds addPackedBounds(PackedBounds left, PackedBounds right) {
+    if (left == packedInfinity || right == packedInfinity) {
+      return packedInfinity;
+    }
+    return left + right - ((left | right) & 1);
+  }
+
+  /*!
+   * @brief The kernel of the canonization: close a square DBM using only the clock \f$x\f$
+   *
+   * It assigns \f$\min(d_{i,j}, d_{i,x} + d_{x,j})\f$ to \f$d_{i,j}\f$ for each \f$i, j\f$, where dbm points to the
+   * DBM stored in the column-major order as in Eigen. We update the DBM column by column so that the innermost loop
+   * accesses contiguous memory.
+   */
+  using PackedCloseKernel = void (*)(PackedBounds *dbm, Eigen::Index size, Eigen::Index x);
+
+  //! @brief The scalar implementation of PackedCloseKernel
+  static inline void closePackedDBM(PackedBounds *dbm, Eigen::Index size, Eigen::Index x) {
+    const PackedBounds *xColumn = dbm + x * size;
+    for (Eigen::Index j = 0; j < size; ++j) {
+      const PackedBounds xj = dbm[j * size + x];
+      if (xj == packedInfinity) {
+        continue;
+      }
+      PackedBounds *column = dbm + j * size;
+      for (Eigen::Index i = 0; i < size; ++i) {
+        column[i] = std::min(column[i], addPackedBounds(xColumn[i], xj));
+      }
+    }
+  }
+
+#ifdef LEARNTA_PACKED_ZONE_AVX2
+  /*!
+   * @brief The implementation of PackedCloseKernel with AVX2, updating eight bounds of a column at once
+   *
+   * The sum is computed without branches, and the lanes where \f$d_{i,x}\f$ is infinity are replaced with infinity.
+   * The overflow in such lanes wraps around and is discarded.
+   */
+  __attribute__((target("avx2")))
+  static inline void closePackedDBMAvx2(PackedBounds *dbm, Eigen::Index size, Eigen::Index x) {
+    const __m256i infinity = _mm256_set1_epi32(packedInfinity);
+    const __m256i one = _mm256_set1_epi32(1);
+    const PackedBounds *xColumn = dbm + x * size;
+    for (Eigen::Index j = 0; j < size; ++j) {
+      const PackedBounds xj = dbm[j * size + x];
+      if (xj == packedInfinity) {
+        continue;
+      }
+      PackedBounds *column = dbm + j * size;
+      const __m256i xjVector = _mm256_set1_epi32(xj);
+      Eigen::Index i = 0;
+      for (; i + 8 <= size; i += 8) {
+        const __m256i ix = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(xColumn + i));
+        const __m256i ij = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(column + i));
+        __m256i sum = _mm256_sub_epi32(_mm256_add_epi32(ix, xjVector),
+                                       _mm256_and_si256(_mm256_or_si256(ix, xjVector), one));
+        sum = _mm256_blendv_epi8(sum, infinity, _mm256_cmpeq_epi32(ix, infinity));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(column + i), _mm256_min_epi32(ij, sum));
+      }
+      for (; i < size; ++i) {
+        column[i] = std::min(column[i], addPackedBounds(xColumn[i], xj));
+      }
+    }
+  }
+#endif
+
+  /*!
+   * @brief The scalar kernel for the DBMs of a fixed size
+   *
+   * Since the loop bounds are compile-time constants, the compiler fully unrolls the loops for small DBMs.
+   */
+  template<int Dimension>
+  static inline void closeFixedPackedDBM(PackedBounds *dbm, Eigen::Index x) {
+    const PackedBounds *xColumn = dbm + x * Dimension;
+    for (int j = 0; j < Dimension; ++j) {
+      const PackedBounds xj = dbm[j * Dimension + x];
+      if (xj == packedInfinity) {
+        continue;
+      }
+      PackedBounds *column = dbm + j * Dimension;
+      for (int i = 0; i < Dimension; ++i) {
+        column[i] = std::min(column[i], addPackedBounds(xColumn[i], xj));
+      }
+    }
+  }
+
+  //! @brief Returns the AVX2 kernel if the CPU supports it. Otherwise, returns nullptr.
+  static inline PackedCloseKernel packedCloseKernelAvx2() {
+#ifdef LEARNTA_PACKED_ZONE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    if (supported) {
+      return closePackedDBMAvx2;
+    }
+#endif
+    return nullptr;
+  }
+
+  /*!
+   * @brief The kernel used in the canonization of a DBM of the given size. We choose it at runtime.
+   *
+   * We use the AVX2 kernel only for the DBMs with at least 16 rows because it does not pay off for smaller DBMs (see
+   * examples/bench_canonize.cc). If the code is compiled for a CPU with AVX2, e.g., with -march=native, the compiler
+   * vectorizes the scalar kernel by itself, and we always use it.
+   */
+  static inline PackedCloseKernel defaultPackedCloseKernel(Eigen::Index size) {
+#ifdef __AVX2__
+    static_cast<void>(size);
+    return closePackedDBM;
+#else
+    static const PackedCloseKernel avx2 = packedCloseKernelAvx2();
+    return (avx2 && size >= 16) ? avx2 : closePackedDBM;
+#endif
+  }
+
+  /*!
+   * @brief The largest dimension of the DBMs for which ta2za uses BasicPackedZone of a fixed size
+   *
+   * For larger DBMs, the unrolled canonization is slower than the vectorized one (see examples/bench_canonize.cc).
+   */
+  static constexpr int maxFixedPackedZoneDimension = 6;
+
+  /*!
+   * @brief A zone with integer constants represented by a DBM of PackedBounds
+   *
+   * It implements the operations used to construct zone automata in the same way as Zone, so that the resulting zones
+   * are the same. Since each bound is a 32-bit integer instead of a pair of double and bool, the DBM is smaller, and the
+   * comparison and the sum of bounds in the canonization are integer operations.
+   *
+   * @tparam Dimension The dimension of the DBM, i.e., the number of the clock variables plus one, or Eigen::Dynamic.
+   * If it is fixed, the DBM and the thresholds are stored in the object itself, and copying the zone requires no heap
+   * allocation. Moreover, the loops in the canonization and the inclusion check are unrolled.
+   * @note We can use it only if all the constants are integers, e.g., the guards and the resets of a timed automaton.
+   */
+  template<int Dimension>
+  struct BasicPackedZone {
+    //! @brief The matrix representing the DBM
+    Eigen::Matrix<PackedBounds, Dimension, Dimension> value;
+    //! @brief The threshold for the normalization. We keep it only to convert back to Zone.
+    Bounds M;
+    //! @brief the threshold of each clock variable
+    std::conditional_t<Dimension == Eigen::Dynamic, std::vector<int>,
+            std::array<int, (Dimension > 0 ? Dimension - 1 : 0)>> maxConstraints;
+
+    BasicPackedZone() = default;
+
+    /*!
+     * @pre All the constants in the zone are integers, and the dimension of the zone is Dimension if it is fixed and at
+     * most maxPackedDimension
+     */
+    explicit BasicPackedZone(const Zone &zone) : value(zone.value.rows(), zone.value.cols()), M(zone.M) {
+      assert(zone.value.rows() <= maxPackedDimension);
+      for (Eigen::Index i = 0; i < value.rows(); ++i) {
+        for (Eigen::Index j = 0; j < value.cols(); ++j) {
+          value(i, j) = packBounds(zone.value(i, j));
+        }
+      }
+      if constexpr (Dimension == Eigen::Dynamic) {
+        maxConstraints.resize(zone.maxConstraints.size());
+      } else {
+        assert(zone.maxConstraints.size() == maxConstraints.size());
+      }
+      for (std::size_t i = 0; i < maxConstraints.size(); ++i) {
+        assert(zone.maxConstraints.at(i) == std::floor(zone.maxConstraints.at(i)));
+        maxConstraints.at(i) = static_cast<int>(zone.maxConstraints.at(i));
+      }
+    }
+
+    //! @brief Convert to Zone
+    [[nodiscard]] Zone toZone() const {
+      Zone zone;
+      zone.value.resize(value.rows(), value.cols());
+      for (Eigen::Index i = 0; i < value.rows(); ++i) {
+        for (Eigen::Index j = 0; j < value.cols(); ++j) {
+          zone.value(i, j) = unpackBounds(value(i, j));
+        }
+      }
+      zone.M = M;
+      zone.maxConstraints.assign(maxConstraints.begin(), maxConstraints.end());
+      return zone;
+    }
+
+    //! @brief Returns if the reset can be applied to a PackedZone, i.e., the assigned constants are integers
+    static bool isIntegral(const std::vector<std::pair<ClockVariables, std::variant<double, ClockVariables>>> &resets) {
+      return std::all_of(resets.begin(), resets.end(), [](const auto &reset) {
+        if (reset.second.index() != 0) {
+          return true;
+        }
+        const double assigned = std::get<double>(reset.second);
+        return assigned == std::floor(assigned) && std::abs(assigned) <= maxPackedConstant;
+      });
+    }
+
+    //! @brief Returns if a diagonal entry is negative, i.e., the zone is known to be unsatisfiable
+    [[nodiscard]] bool hasNegativeDiagonal() const {
+      return (value.diagonal().array() < packBounds(0, true)).any();
+    }
+
+    /*!
+     * @brief Close using only x
+     *
+     * Unlike Zone::close1, the kernel updates the DBM column by column. The result is the same if the zone is
+     * satisfiable. If a diagonal entry is already negative, we do nothing to avoid the overflow of the bounds.
+     */
+    void close1(Eigen::Index x) {
+      if (hasNegativeDiagonal()) {
+        return;
+      }
+      if constexpr (Dimension == Eigen::Dynamic) {
+        defaultPackedCloseKernel(value.rows())(value.data(), value.rows(), x);
+      } else {
+        closeFixedPackedDBM<Dimension>(value.data(), x);
+      }
+    }
+
+    /*!
+     * @brief make the zone canonical with the given kernel
+     *
+     * As in close1, we stop once a diagonal entry is negative.
+     */
+    void canonize(PackedCloseKernel kernel) {
+      for (Eigen::Index k = 0; k < value.cols() && !hasNegativeDiagonal(); ++k) {
+        kernel(value.data(), value.rows(), k);
+      }
+    }
+
+    //! @brief make the zone canonical
+    void canonize() {
+      for (Eigen::Index k = 0; k < value.cols(); ++k) {
+        close1(k);
+      }
+    }
+
+    /*!
+     * @brief check if the zone is satisfiable
+     *
+     * @pre The zone is canonical
+     */
+    [[nodiscard]] bool isSatisfiableNoCanonize() const {
+      for (Eigen::Index i = 0; i < value.rows(); ++i) {
+        for (Eigen::Index j = 0; j < value.cols(); ++j) {
+          if (addPackedBounds(value(i, j), value(j, i)) < packBounds(0, true)) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
+    //! @brief check if the zone is satisfiable
+    bool isSatisfiable() {
+      canonize();
+      return this->isSatisfiableNoCanonize();
+    }
+
+    //! @brief check if the zone is satisfiable
+    explicit operator bool() {
+      return isSatisfiable();
+    }
+
+    //! @brief add the constraint \f$x - y \le (c,s)\f$
+    void tighten(ClockVariables x, ClockVariables y, PackedBounds c) {
+      x++;
+      y++;
+      value(x, y) = std::min(value(x, y), c);
+      close1(x);
+      close1(y);
+    }
+
+    //! @brief Add a guard of a timed automaton
+    void tighten(const Constraint &constraint) {
+      switch (constraint.odr) {
+        case learnta::Constraint::Order::ge:
+          this->tighten(-1, constraint.x, packBounds(-constraint.c, true));
+          break;
+        case learnta::Constraint::Order::gt:
+          this->tighten(-1, constraint.x, packBounds(-constraint.c, false));
+          break;
+        case learnta::Constraint::Order::le:
+          this->tighten(constraint.x, -1, packBounds(constraint.c, true));
+          break;
+        case learnta::Constraint::Order::lt:
+          this->tighten(constraint.x, -1, packBounds(constraint.c, false));
+          break;
+      }
+    }
+
+    //! @brief Add a set of guards of a timed automaton
+    void tighten(const std::vector<Constraint> &constraints) {
+      for (const auto &constraint: constraints) {
+        this->tighten(constraint);
+      }
+    }
+
+    //! @brief Unconstrain the constraint on this clock
+    void unconstrain(ClockVariables x) {
+      x++;
+      value.col(x).fill(packedInfinity);
+      value.row(x).fill(packedInfinity);
+    }
+
+    //! @pre isIntegral(resets)
+    void applyResets(const std::vector<std::pair<ClockVariables, std::variant<double, ClockVariables>>> &resets) {
+      // We apply renaming first
+      for (const auto &[resetVariable, updatedVariable]: resets) {
+        if (updatedVariable.index() == 1 && resetVariable != std::get<ClockVariables>(updatedVariable)) {
+          this->unconstrain(resetVariable);
+          this->value(resetVariable + 1, std::get<ClockVariables>(updatedVariable) + 1) = packBounds(0, true);
+          this->value(std::get<ClockVariables>(updatedVariable) + 1, resetVariable + 1) = packBounds(0, true);
+          canonize();
+        }
+      }
+      // Then, assign a value
+      for (const auto &[resetVariable, updatedVariable]: resets) {
+        if (updatedVariable.index() == 0) {
+          const auto assigned = static_cast<int>(std::get<double>(updatedVariable));
+          this->unconstrain(resetVariable);
+          this->value(0, resetVariable + 1) = packBounds(-assigned, true);
+          this->value(resetVariable + 1, 0) = packBounds(assigned, true);
+          canonize();
+        }
+      }
+    }
+
+    /*!
+     * @brief Apply the resets to a canonical zone without canonizing it in the same way as Zone::applyResetsCanonical
+     *
+     * @pre The zone is canonical and satisfiable, and isIntegral(resets)
+     * @post The zone is the same as the one by applyResets followed by canonize, and it is canonical
+     */
+    void applyResetsCanonical(const std::vector<std::pair<ClockVariables, std::variant<double, ClockVariables>>> &resets) {
+      // We apply renaming first
+      for (const auto &[resetVariable, updatedVariable]: resets) {
+        if (updatedVariable.index() == 1 && resetVariable != std::get<ClockVariables>(updatedVariable)) {
+          this->copy(resetVariable, std::get<ClockVariables>(updatedVariable));
+        }
+      }
+      // Then, assign a value
+      for (const auto &[resetVariable, updatedVariable]: resets) {
+        if (updatedVariable.index() == 0) {
+          this->assign(resetVariable, static_cast<int>(std::get<double>(updatedVariable)));
+        }
+      }
+    }
+
+    //! @brief Assign the value of the clock variable y to x in the same way as Zone::copy
+    void copy(ClockVariables x, ClockVariables y) {
+      x++;
+      y++;
+      value.row(x) = value.row(y);
+      value.col(x) = value.col(y);
+      value(x, y) = packBounds(0, true);
+      value(y, x) = packBounds(0, true);
+      value(x, x) = packBounds(0, true);
+      value(y, y) = std::min(value(y, y), packBounds(0, true));
+    }
+
+    //! @brief Assign a constant value to the clock variable x in the same way as Zone::assign
+    void assign(ClockVariables x, int c) {
+      x++;
+      for (Eigen::Index j = 1; j < value.cols(); ++j) {
+        value(x, j) = addPackedBounds(packBounds(c, true), value(0, j));
+        value(j, x) = addPackedBounds(value(j, 0), packBounds(-c, true));
+      }
+      value(0, x) = packBounds(-c, true);
+      value(x, 0) = packBounds(c, true);
+      value(x, x) = packBounds(0, true);
+      value(0, 0) = std::min(value(0, 0), packBounds(0, true));
+    }
+
+    /*!
+     * @brief Assign the strongest post-condition of the delay
+     *
+     * @note We allow time elapse of duration zero
+     */
+    void elapse() {
+      value.col(0).fill(packedInfinity);
+    }
+
+    //! @brief Extrapolate the zone in the same way as Zone::extrapolate
+    void extrapolate() {
+      for (std::size_t i = 0; i < this->maxConstraints.size(); ++i) {
+        if (packedConstant(value(i + 1, 0)) > this->maxConstraints.at(i)) {
+          value(i + 1, 0) = packedInfinity;
+        }
+        if (-packedConstant(value(0, i + 1)) > this->maxConstraints.at(i)) {
+          value(0, i + 1) = packBounds(-this->maxConstraints.at(i), false);
+        }
+        for (std::size_t j = 0; j < this->maxConstraints.size(); ++j) {
+          if (packedConstant(value(i + 1, j + 1)) > this->maxConstraints.at(i)) {
+            value(i + 1, j + 1) = packedInfinity;
+          } else if (-packedConstant(value(0, i + 1)) > this->maxConstraints.at(i)) {
+            value(i + 1, j + 1) = packedInfinity;
+          } else if (-packedConstant(value(0, j + 1)) > this->maxConstraints.at(j)) {
+            value(i + 1, j + 1) = packedInfinity;
+          }
+        }
+      }
+    }
+
+    //! @brief Extrapolate the zone in the same way as Zone::extrapolateLU
+    void extrapolateLU(const std::vector<int> &lowerBounds, const std::vector<int> &upperBounds) {
+      assert(lowerBounds.size() + 1 == static_cast<std::size_t>(value.cols()));
+      assert(upperBounds.size() + 1 == static_cast<std::size_t>(value.cols()));
+      // The bounds 0 - x before the extrapolation
+      const Eigen::Matrix<PackedBounds, 1, Dimension> lower = value.row(0);
+      for (std::size_t i = 0; i < lowerBounds.size(); ++i) {
+        const bool beyondLower = -packedConstant(lower(i + 1)) > lowerBounds.at(i);
+        for (std::size_t j = 0; j <= lowerBounds.size(); ++j) {
+          if (i + 1 == j) {
+            continue;
+          }
+          if (beyondLower || packedConstant(value(i + 1, j)) > lowerBounds.at(i) ||
+              (j > 0 && -packedConstant(lower(j)) > upperBounds.at(j - 1))) {
+            value(i + 1, j) = packedInfinity;
+          }
+        }
+      }
+      for (std::size_t j = 0; j < upperBounds.size(); ++j) {
+        if (-packedConstant(lower(j + 1)) > upperBounds.at(j)) {
+          value(0, j + 1) = packBounds(-upperBounds.at(j), false);
+        }
+      }
+    }
+
+    /*!
+     * @brief Return if this zone includes the given zone
+     *
+     * @pre both this and the given zones are canonized
+     */
+    [[nodiscard]] bool includes(const BasicPackedZone &zone) const {
+      return (this->value.array() >= zone.value.array()).all();
+    }
+
+    bool operator==(const BasicPackedZone &z) const {
+      return value.cols() == z.value.cols() && value == z.value;
+    }
+  };
+
+  //! @brief PackedZone of any dimension
+  using PackedZone = BasicPackedZone<Eigen::Dynamic>;
+
+  /*!
+   * @brief The hash value of the zone
+   *
+   * It is the same as the hash value of the corresponding Zone. Therefore, the unordered containers of PackedZone are
+   * iterated in the same order as those of Zone, and ta2za constructs the same zone automaton with both of them.
+   */
+  template<int Dimension>
+  inline std::size_t hash_value(learnta::BasicPackedZone<Dimension> const &zone) {
+    std::size_t seed = zone.value.size();
+    for (auto it = zone.value.data(); it != zone.value.data() + zone.value.size(); it++) {
+      hashCombineBounds(seed, unpackBounds(*it));
+    }
+    return seed;
+  }
+}
@@ -0,0 +1,75 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "sul.hh"
+#include "membership_oracle.hh"
+#include "thread_pool.hh"
+
+namespace learnta {
+  /*!
+   * @brief Membership oracle answering a batch of queries concurrently with clones of an SUL
+   *
+   * Each worker of the thread pool owns one instance of the SUL, and the timed words in a batch are fed to them in
+   * parallel.
+   */
+  class ParallelMembershipOracle final : public MembershipOracle {
+  private:
+    ThreadPool pool;
+    //! @brief The SULs. The i-th one is used only by the i-th worker.
+    std::vector<std::unique_ptr<SUL>> suls;
+
+  public:
+    /*!
+     * @param sul The SUL to use. It is cloned for each additional worker.
+     * @param numThreads The number of threads. If it is 0, we use the hardware concurrency.
+     * @throws std::invalid_argument if we need a clone of the SUL but it does not support SUL::clone
+     */
+    ParallelMembershipOracle(std::unique_ptr<SUL> &&sul, std::size_t numThreads) : pool(numThreads) {
+      suls.reserve(pool.size());
+      suls.push_back(std::move(sul));
+      while (suls.size() < pool.size()) {
+        auto clone = suls.front()->clone();
+        if (!clone) {
+          throw std::invalid_argument("ParallelMembershipOracle: the given SUL does not support clone()");
+        }
+        suls.push_back(std::move(clone));
+      }
+    }
+
+    bool answerQuery(const TimedWord &timedWord) override {
+      return suls.front()->execute(timedWord);
+    }
+
+    std::vector<bool> answerQueries(const std::vector<TimedWord> &timedWords) override {
+      // We use char rather than bool because std::vector<bool> is not safe for concurrent writes
+      std::vector<char> accepted(timedWords.size());
+      pool.parallelFor(timedWords.size(), [&](std::size_t i, std::size_t workerId) {
+        accepted.at(i) = suls.at(workerId)->execute(timedWords.at(i));
+      });
+
+      return {accepted.begin(), accepted.end()};
+    }
+
+    //! @brief The total number of the queries to all the SULs
+    [[nodiscard]] std::size_t count() const override {
+      return std::accumulate(suls.begin(), suls.end(), std::size_t{0}, [](std::size_t sum, const auto &sul) {
+        return sum + sul->count();
+      });
+    }
+
+    //! @brief Print the executions of the SULs. Each query is one execution.
+    std::ostream &printStatistics(std::ostream &stream) const override {
+      stream << "Number of SUL executions: " << this->count() << "\n";
+
+      return stream;
+    }
+  };
+}
@@ -0,0 +1,239 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "membership_oracle.hh"
+#include "timed_word.hh"
+
+namespace learnta {
+  /*!
+   * @brief Wrapper of a membership oracle persisting the answers to a file
+   *
+   * The answers are appended to the file, and the answers in the file are used in the later runs. The file consists of
+   * the header and the records. The header is the magic number and the fingerprint of the target system, and we discard
+   * the content of the file if they do not match. Each record is the length \f$n\f$ of the word (uint32_t), the \f$n\f$
+   * actions, the \f$n + 1\f$ durations (double), and the answer (uint8_t). All the values are in the native byte order.
+   * We ignore the truncated record at the end, e.g., by a crash, and overwrite it.
+   *
+   * The file is mapped read-only at the first query, and we keep only the hash value and the offset of each record in
+   * memory. The answers obtained in this run are only appended to the file. This oracle is meant to be wrapped by
+   * MembershipOracleCache, which answers the repeated queries in this run. A timed word asked again after it is evicted
+   * from that cache is appended again, and the duplicated records are harmless.
+   */
+  class PersistentMembershipOracle final : public MembershipOracle {
+  private:
+    static constexpr std::array<char, 8> magic = {'L', 'T', 'A', 'M', 'Q', 'v', '0', '1'};
+    static constexpr std::size_t headerSize = magic.size() + sizeof(std::uint64_t);
+    std::unique_ptr<MembershipOracle> oracle;
+    const std::filesystem::path path;
+    const std::uint64_t targetFingerprint;
+    boost::interprocess::mapped_region region;
+    //! @brief The pairs of the hash value and the offset of the records in the file, sorted by the hash value
+    std::vector<std::pair<std::size_t, std::size_t>> recordIndex;
+    std::ofstream output;
+    bool loaded = false;
+    std::size_t countStored = 0;
+
+    //! @brief The hash value of a timed word given by its actions and durations
+    static std::size_t hashRecord(const char *word, std::size_t wordSize, const char *durations) {
+      std::size_t hash = boost::hash_range(word, word + wordSize);
+      for (std::size_t i = 0; i <= wordSize; ++i) {
+        double duration;
+        std::memcpy(&duration, durations + i * sizeof(double), sizeof(double));
+        boost::hash_combine(hash, duration);
+      }
+      return hash;
+    }
+
+    //! @brief Map the records in the file and open it to append new records
+    void load() {
+      namespace bip = boost::interprocess;
+      loaded = true;
+      std::uintmax_t validSize = 0;
+      std::error_code errorCode;
+      const auto fileSize = std::filesystem::file_size(path, errorCode);
+      if (!errorCode && fileSize >= headerSize) {
+        bip::file_mapping mapping{path.c_str(), bip::read_only};
+        region = bip::mapped_region{mapping, bip::read_only};
+        validSize = this->parse(static_cast<const char *>(region.get_address()), region.get_size());
+        if (validSize < fileSize) {
+          // Do not keep the mapping of the part to be truncated
+          region = bip::mapped_region{};
+          if (validSize > 0) {
+            BOOST_LOG_TRIVIAL(warning) << "PersistentMembershipOracle: ignore the truncated record in " << path;
+            std::filesystem::resize_file(path, validSize);
+            region = bip::mapped_region{mapping, bip::read_only, 0, validSize};
+          }
+        }
+      }
+      if (validSize == 0) {
+        // The file is missing, broken, or for another target
+        recordIndex.clear();
+        output.open(path, std::ios::binary | std::ios::trunc);
+        output.write(magic.data(), magic.size());
+        output.write(reinterpret_cast<const char *>(&targetFingerprint), sizeof(targetFingerprint));
+        output.flush();
+      } else {
+        output.open(path, std::ios::binary | std::ios::app);
+      }
+      if (!output) {
+        BOOST_LOG_TRIVIAL(error) << "PersistentMembershipOracle: failed to open " << path;
+      }
+    }
+
+    /*!
+     * @brief Index the records in the file
+     *
+     * @returns The size of the valid prefix of the content, or 0 if the header is invalid
+     */
+    std::size_t parse(const char *begin, std::size_t size) {
+      std::uint64_t fingerprint;
+      if (std::memcmp(begin, magic.data(), magic.size()) != 0) {
+        return 0;
+      }
+      std::memcpy(&fingerprint, begin + magic.size(), sizeof(fingerprint));
+      if (fingerprint != targetFingerprint) {
+        return 0;
+      }
+      std::size_t position = headerSize;
+      while (position + sizeof(std::uint32_t) <= size) {
+        std::uint32_t wordSize;
+        std::memcpy(&wordSize, begin + position, sizeof(wordSize));
+        const std::size_t recordSize = sizeof(std::uint32_t) + wordSize + (wordSize + 1) * sizeof(double) + 1;
+        if (position + recordSize > size) {
+          break;
+        }
+        const char *wordBegin = begin + position + sizeof(std::uint32_t);
+        recordIndex.emplace_back(hashRecord(wordBegin, wordSize, wordBegin + wordSize), position);
+        position += recordSize;
+      }
+      // The stable sort keeps the first one of the duplicated records first
+      std::stable_sort(recordIndex.begin(), recordIndex.end(), [](const auto &left, const auto &right) {
+        return left.first < right.first;
+      });
+
+      return position;
+    }
+
+    /*!
+     * @brief Find the answer of the timed word in the file
+     *
+     * @returns The pointer to the answer in the mapped file, or nullptr if the timed word is not in the file
+     */
+    [[nodiscard]] const char *find(const TimedWord &timedWord) const {
+      const auto wordSize = timedWord.wordSize();
+      const auto *durations = reinterpret_cast<const char *>(timedWord.getDurations().data());
+      const auto hash = hashRecord(timedWord.getWord().data(), wordSize, durations);
+      auto it = std::lower_bound(recordIndex.begin(), recordIndex.end(), hash, [](const auto &entry, std::size_t value) {
+        return entry.first < value;
+      });
+      const auto *begin = static_cast<const char *>(region.get_address());
+      for (; it != recordIndex.end() && it->first == hash; ++it) {
+        const char *record = begin + it->second;
+        std::uint32_t recordWordSize;
+        std::memcpy(&recordWordSize, record, sizeof(recordWordSize));
+        const char *recordWord = record + sizeof(std::uint32_t);
+        if (recordWordSize == wordSize && std::memcmp(recordWord, timedWord.getWord().data(), wordSize) == 0 &&
+            std::memcmp(recordWord + wordSize, durations, (wordSize + 1) * sizeof(double)) == 0) {
+          return recordWord + wordSize + (wordSize + 1) * sizeof(double);
+        }
+      }
+
+      return nullptr;
+    }
+
+    void append(const TimedWord &timedWord, bool answer) {
+      const auto wordSize = static_cast<std::uint32_t>(timedWord.wordSize());
+      const char answerByte = answer;
+      output.write(reinterpret_cast<const char *>(&wordSize), sizeof(wordSize));
+      output.write(timedWord.getWord().data(), wordSize);
+      output.write(reinterpret_cast<const char *>(timedWord.getDurations().data()),
+                   static_cast<std::streamsize>((wordSize + 1) * sizeof(double)));
+      output.write(&answerByte, 1);
+    }
+
+  public:
+    /*!
+     * @param oracle The membership oracle to answer the queries not in the file
+     * @param path The path to the file
+     * @param targetFingerprint The value identifying the target system, e.g., fingerprint() of its description
+     */
+    PersistentMembershipOracle(std::unique_ptr<MembershipOracle> &&oracle, std::filesystem::path path,
+                               std::uint64_t targetFingerprint) : oracle(std::move(oracle)), path(std::move(path)),
+                                                                  targetFingerprint(targetFingerprint) {}
+
+    /*!
+     * @brief The 64-bit FNV-1a hash of the given string
+     *
+     * We do not use std::hash because its value may differ between the builds.
+     */
+    static std::uint64_t fingerprint(const std::string &description) {
+      std::uint64_t hash = 0xcbf29ce484222325ULL;
+      for (const char c: description) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+      }
+      return hash;
+    }
+
+    bool answerQuery(const TimedWord &timedWord) override {
+      return this->answerQueries({timedWord}).front();
+    }
+
+    std::vector<bool> answerQueries(const std::vector<TimedWord> &timedWords) override {
+      if (!loaded) {
+        this->load();
+      }
+      std::vector<bool> result(timedWords.size());
+      std::vector<TimedWord> missed;
+      std::vector<std::size_t> missedIndices;
+      for (std::size_t i = 0; i < timedWords.size(); ++i) {
+        if (const char *answer = this->find(timedWords.at(i))) {
+          ++countStored;
+          result.at(i) = *answer != 0;
+        } else {
+          missed.push_back(timedWords.at(i));
+          missedIndices.push_back(i);
+        }
+      }
+      if (missed.empty()) {
+        return result;
+      }
+      const auto missedResult = this->oracle->answerQueries(missed);
+      for (std::size_t i = 0; i < missed.size(); ++i) {
+        result.at(missedIndices.at(i)) = missedResult.at(i);
+        this->append(missed.at(i), missedResult.at(i));
+      }
+      output.flush();
+
+      return result;
+    }
+
+    [[nodiscard]] std::size_t count() const override {
+      return this->oracle->count();
+    }
+
+    std::ostream &printStatistics(std::ostream &stream) const override {
+      stream << "Number of membership queries answered by the persistent cache: " << countStored << "\n";
+      return this->oracle->printStatistics(stream);
+    }
+  };
+}
@@ -0,0 +1,152 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "sul.hh"
+#include "timed_word.hh"
+#include "sink_prefix_trie.hh"
+
+namespace learnta {
+  /*!
+   * @brief Scheduler to feed a batch of timed words to an SUL sharing their common prefixes
+   *
+   * We view a timed word \f$\tau_0 a_1 \tau_1 \dots a_n \tau_n\f$ as the sequence of the steps fed to the SUL and
+   * construct the prefix trie of the batch. Then, we traverse the trie in the depth-first order so that each common
+   * prefix is executed only once. At each branching node, we take a snapshot of the SUL and restore it before
+   * executing each of the other branches. If the SUL reports a rejecting sink, we skip the subtree and record the prefix.
+   *
+   * @note If the SUL does not support snapshots, we fall back to SUL::executeBatch.
+   */
+  class PrefixTrieScheduler {
+  public:
+    //! @brief The executions of the SUL and the steps fed to it
+    struct Statistics {
+      std::size_t executions = 0;
+      std::size_t steps = 0;
+    };
+
+  private:
+    struct Node {
+      std::map<SULStep, std::unique_ptr<Node>> children;
+      //! @brief The indices of the timed words ending at this node
+      std::vector<std::size_t> indices;
+      //! @brief The index of a timed word passing this node
+      std::size_t representative;
+      //! @brief The number of the steps to this node
+      std::size_t depth;
+    };
+
+    SUL &sul;
+    const std::vector<TimedWord> &timedWords;
+    SinkPrefixTrie *sinkPrefixes;
+    Statistics *statistics;
+    Node root;
+    //! @brief The result of each timed word. Unless we reach the end of a timed word, it is rejected.
+    std::vector<char> accepted;
+
+    PrefixTrieScheduler(SUL &sul, const std::vector<TimedWord> &timedWords, SinkPrefixTrie *sinkPrefixes,
+                        Statistics *statistics) :
+            sul(sul), timedWords(timedWords), sinkPrefixes(sinkPrefixes), statistics(statistics), root{{}, {}, 0, 0},
+            accepted(timedWords.size()) {
+      for (std::size_t i = 0; i < timedWords.size(); ++i) {
+        this->insert(i);
+      }
+    }
+
+    void insert(std::size_t index) {
+      const TimedWord &timedWord = timedWords.at(index);
+      Node *node = &root;
+      for (std::size_t i = 0; i < numSteps(timedWord); ++i) {
+        auto &next = node->children[nthStep(timedWord, i)];
+        if (!next) {
+          next = std::make_unique<Node>(Node{{}, {}, index, i + 1});
+        }
+        node = next.get();
+      }
+      node->indices.push_back(index);
+    }
+
+    /*!
+     * @brief Execute the subtree rooted by the given node
+     *
+     * @pre The configuration of the SUL is the one after the steps to the node
+     * @param result The result of the last step to the node
+     */
+    void visit(const Node &node, bool result) {
+      for (const std::size_t index: node.indices) {
+        accepted.at(index) = result;
+      }
+      std::unique_ptr<SULState> snapshot;
+      if (node.children.size() > 1) {
+        snapshot = sul.save();
+      }
+      bool first = true;
+      for (const auto &[step, child]: node.children) {
+        if (!first) {
+          sul.post();
+          sul.restore(*snapshot);
+          if (statistics) {
+            ++statistics->executions;
+          }
+        }
+        first = false;
+        const bool childResult = std::visit([&](auto value) {
+          return sul.step(value);
+        }, step);
+        if (statistics) {
+          ++statistics->steps;
+        }
+        if (sul.inRejectingSink()) {
+          // All the timed words in the subtree are rejected
+          if (sinkPrefixes) {
+            sinkPrefixes->add(timedWords.at(child->representative), child->depth);
+          }
+          continue;
+        }
+        visit(*child, childResult);
+      }
+    }
+
+  public:
+    /*!
+     * @brief Feed each of the timed words from the initial configuration
+     *
+     * Each of the timed words is counted as a query by the SUL, even if it is answered by a shared execution.
+     *
+     * @param sinkPrefixes If it is not nullptr, we register the prefixes leading to a rejecting sink
+     * @param statistics If it is not nullptr, we add the executions of the SUL and the steps fed to it. In the fallback
+     * to SUL::executeBatch, we count the steps as if no execution stops at a rejecting sink.
+     * @returns The vector showing if each of the timed words is accepted
+     */
+    static std::vector<bool> execute(SUL &sul, const std::vector<TimedWord> &timedWords,
+                                     SinkPrefixTrie *sinkPrefixes = nullptr, Statistics *statistics = nullptr) {
+      if (timedWords.empty() || !sul.save()) {
+        if (statistics) {
+          statistics->executions += timedWords.size();
+          for (const auto &timedWord: timedWords) {
+            statistics->steps += numSteps(timedWord);
+          }
+        }
+        return sul.executeBatch(timedWords);
+      }
+      PrefixTrieScheduler scheduler{sul, timedWords, sinkPrefixes, statistics};
+      sul.pre();
+      if (statistics) {
+        ++statistics->executions;
+      }
+      scheduler.visit(scheduler.root, false);
+      sul.post();
+      // pre() counted only one of the timed words
+      sul.countSharedQueries(timedWords.size() - 1);
+
+      return {scheduler.accepted.begin(), scheduler.accepted.end()};
+    }
+  };
+}
@@ -219,6 +219,26 @@ namespace learnta {
         return this->rightVariables().size() == this->size();
       }
 
+    //! @brief Write the renaming relation in the binary format
+    void save(BinaryWriter &writer) const {
+      writer.writeSize(this->size());
+      for (const auto &[left, right]: *this) {
+        writer.writeSize(left);
+        writer.writeSize(right);
+      }
+    }
+
+    //! @brief Read the renaming relation written by save
+    static RenamingRelation load(BinaryReader &reader) {
+      RenamingRelation relation;
+      relation.resize(reader.readSize());
+      for (auto &[left, right]: relation) {
+        left = reader.readSize();
+        right = reader.readSize();
+      }
+      return relation;
+    }
+
     friend std::ostream &operator<<(std::ostream &os, const RenamingRelation &relation) {
       bool isFirst = true;
       os << '{';
@@ -0,0 +1,120 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "sul.hh"
+#include "timed_word.hh"
+
+namespace learnta {
+  /*!
+   * @brief Trie of the prefixes of timed words leading an SUL to a rejecting sink
+   *
+   * A prefix is a sequence of the steps fed to the SUL (see nthStep). Any timed word with a prefix in the trie is
+   * rejected without executing it. Since the trie is only for efficiency, we clear it when the number of its nodes
+   * exceeds the capacity.
+   */
+  class SinkPrefixTrie {
+  private:
+    struct Node {
+      //! @brief If the steps to this node lead to a rejecting sink
+      bool sink = false;
+      std::map<SULStep, std::unique_ptr<Node>> children;
+    };
+    Node root;
+    std::size_t capacity;
+    //! @brief The number of the nodes except for the root
+    std::size_t numNodes = 0;
+
+    static std::size_t countDescendants(const Node &node) {
+      std::size_t count = node.children.size();
+      for (const auto &[step, child]: node.children) {
+        count += countDescendants(*child);
+      }
+      return count;
+    }
+
+  public:
+    static constexpr std::size_t defaultCapacity = 1 << 16;
+
+    /*!
+     * @param capacity The maximum number of the nodes. 0 means unbounded.
+     */
+    explicit SinkPrefixTrie(std::size_t capacity = defaultCapacity) : capacity(capacity) {}
+
+    /*!
+     * @brief Register that the first n steps of the timed word lead to a rejecting sink
+     *
+     * If the new nodes exceed the capacity, we clear the trie before adding them.
+     */
+    void add(const TimedWord &timedWord, std::size_t n) {
+      // Follow the existing nodes
+      Node *node = &root;
+      std::size_t depth = 0;
+      for (; depth < n; ++depth) {
+        if (node->sink) {
+          // A shorter prefix is already registered
+          return;
+        }
+        auto it = node->children.find(nthStep(timedWord, depth));
+        if (it == node->children.end()) {
+          break;
+        }
+        node = it->second.get();
+      }
+      if (capacity > 0 && numNodes + (n - depth) > capacity) {
+        if (n > capacity) {
+          return;
+        }
+        this->clear();
+        node = &root;
+        depth = 0;
+      }
+      for (; depth < n; ++depth) {
+        auto &next = node->children[nthStep(timedWord, depth)];
+        next = std::make_unique<Node>();
+        ++numNodes;
+        node = next.get();
+      }
+      if (!node->sink) {
+        node->sink = true;
+        // The longer prefixes are now redundant
+        numNodes -= countDescendants(*node);
+        node->children.clear();
+      }
+    }
+
+    //! @brief Remove all the prefixes
+    void clear() {
+      root.sink = false;
+      root.children.clear();
+      numNodes = 0;
+    }
+
+    //! @brief The number of the nodes except for the root
+    [[nodiscard]] std::size_t size() const {
+      return numNodes;
+    }
+
+    /*!
+     * @brief Check if the timed word has a prefix leading to a rejecting sink
+     */
+    [[nodiscard]] bool rejects(const TimedWord &timedWord) const {
+      const Node *node = &root;
+      const std::size_t n = numSteps(timedWord);
+      for (std::size_t i = 0; i < n && !node->sink; ++i) {
+        auto it = node->children.find(nthStep(timedWord, i));
+        if (it == node->children.end()) {
+          return false;
+        }
+        node = it->second.get();
+      }
+
+      return node->sink;
+    }
+  };
+}
@@ -5,7 +5,44 @@
 
 #pragma once
 
+#include <memory>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "timed_word.hh"
+
 namespace learnta {
+  //! @brief A step fed to an SUL, i.e., a time elapse or a discrete action
+  using SULStep = std::variant<double, char>;
+
+  /*!
+   * @brief The number of the steps to feed a timed word \f$\tau_0 a_1 \tau_1 \dots a_n \tau_n\f$, i.e., \f$2n + 1\f$
+   */
+  inline std::size_t numSteps(const TimedWord &timedWord) {
+    return 2 * timedWord.wordSize() + 1;
+  }
+
+  /*!
+   * @brief The i-th step to feed a timed word \f$\tau_0 a_1 \tau_1 \dots a_n \tau_n\f$
+   */
+  inline SULStep nthStep(const TimedWord &timedWord, std::size_t i) {
+    if (i % 2 == 0) {
+      return timedWord.getDurations().at(i / 2);
+    } else {
+      return timedWord.getWord().at(i / 2);
+    }
+  }
+
+  /*!
+   * @brief Snapshot of the configuration of a system under learning
+   *
+   * Each SUL supporting snapshots defines its own subclass.
+   */
+  struct SULState {
+    virtual ~SULState() = default;
+  };
+
   /*!
    * @brief Interface of the system under learning
    */
@@ -32,5 +69,95 @@ namespace learnta {
      * @brief Returns the number of queries
      */
     [[nodiscard]] virtual std::size_t count() const = 0;
+
+    /*!
+     * @brief Make a fresh instance of the same system under learning
+     *
+     * The returned instance must be usable concurrently with this instance. Its count() starts from zero.
+     *
+     * @returns The new instance, or nullptr if the SUL cannot be duplicated
+     */
+    [[nodiscard]] virtual std::unique_ptr<SUL> clone() const {
+      return nullptr;
+    }
+
+    /*!
+     * @brief Check if the current configuration is in a rejecting sink, i.e., any continuation is rejected
+     *
+     * An SUL may conservatively return false. The default implementation always returns false.
+     */
+    [[nodiscard]] virtual bool inRejectingSink() const {
+      return false;
+    }
+
+    /*!
+     * @brief Take a snapshot of the current configuration
+     *
+     * It may be called at any time, e.g., before pre() to check if snapshots are supported.
+     *
+     * @returns The snapshot, or nullptr if the SUL does not support snapshots
+     */
+    [[nodiscard]] virtual std::unique_ptr<SULState> save() const {
+      return nullptr;
+    }
+
+    /*!
+     * @brief Start a new execution from the configuration in the snapshot
+     *
+     * This is used in place of pre() and followed by post(). The snapshot must be taken by save() of this instance.
+     * Unlike pre(), this is not counted as a query.
+     */
+    virtual void restore(const SULState &) {
+      throw std::logic_error("SUL::restore: this SUL does not support snapshots");
+    }
+
+    /*!
+     * @brief Count the timed words answered by shared executions in addition to the ones counted by pre()
+     *
+     * PrefixTrieScheduler answers a batch of timed words with fewer executions, and SULMembershipOracle answers the
+     * timed words with a known sink prefix without any execution. Both call this so that count() is the number of the
+     * answered timed words. An SUL supporting snapshots should override this. The default implementation does nothing.
+     */
+    virtual void countSharedQueries(std::size_t) {}
+
+    /*!
+     * @brief Feed a timed word from the initial configuration
+     *
+     * @returns If the timed word is accepted
+     */
+    bool execute(const TimedWord &timedWord) {
+      this->pre();
+      const std::string &word = timedWord.getWord();
+      const std::vector<double> &durations = timedWord.getDurations();
+      bool result = this->step(durations.front());
+      for (std::size_t i = 0; i < timedWord.wordSize(); i++) {
+        this->step(word[i]);
+        if (this->inRejectingSink()) {
+          // The remaining steps do not change the result
+          result = false;
+          break;
+        }
+        result = this->step(durations[i + 1]);
+      }
+      this->post();
+
+      return result;
+    }
+
+    /*!
+     * @brief Feed each of the timed words from the initial configuration
+     *
+     * @returns The vector showing if each of the timed words is accepted
+     * @note The default implementation feeds the timed words one by one. An SUL with a large overhead per call, e.g., an external simulator, may override it to handle the entire batch at once.
+     */
+    virtual std::vector<bool> executeBatch(const std::vector<TimedWord> &timedWords) {
+      std::vector<bool> result;
+      result.reserve(timedWords.size());
+      for (const auto &timedWord: timedWords) {
+        result.push_back(this->execute(timedWord));
+      }
+
+      return result;
+    }
   };
-}
\ No newline at end of file
+}
@@ -5,29 +5,112 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
 #include "elementary_language.hh"
 #include "sul.hh"
 #include "membership_oracle.hh"
+#include "persistent_membership_oracle.hh"
 #include "timed_condition_set.hh"
+#include "lru_cache.hh"
+#include "thread_pool.hh"
 
 namespace learnta {
   /*!
    * @brief The oracle to answer symbolic membership queries
+   *
+   * Both the symbolic and the concrete membership queries are cached. Moreover, the membership of each simple elementary
+   * language is cached so that a symbolic query overlapping with the previous ones only asks the missing simple
+   * elementary languages. Each cache can be bounded by a capacity, and the least recently used entry is evicted when
+   * the capacity is exceeded.
    */
   class SymbolicMembershipOracle final : public MembershipOracle {
   private:
-    std::unique_ptr<MembershipOracle> membershipOracle;
-    boost::unordered_map<ElementaryLanguage, TimedConditionSet> cache;
+    std::unique_ptr<MembershipOracleCache> membershipOracle;
+    LRUCache<ElementaryLanguage, TimedConditionSet> cache;
+    //! @brief The cache of the membership of the simple elementary languages
+    LRUCache<ElementaryLanguage, bool> simpleCache;
     std::size_t countSymbolic = 0;
     std::size_t countSymbolicWithCache = 0;
 
-    [[nodiscard]] bool included(const ElementaryLanguage &elementary) {
-      return this->membershipOracle->answerQuery(elementary.sample());
+    /*!
+     * @brief Construct the result of a symbolic membership query from the membership of its simple elementary languages
+     *
+     * @param elementary The elementary language of the query
+     * @param simpleLanguages The simple elementary languages in elementary
+     * @param included included.at(i) shows if simpleLanguages.at(i) is in the target language
+     */
+    static TimedConditionSet simplify(const ElementaryLanguage &elementary,
+                                      const std::vector<ElementaryLanguage> &simpleLanguages,
+                                      const std::vector<char> &included) {
+      // Classify the simple conditions maintaining the convex hull of the included ones
+      std::vector<TimedCondition> includedConditions, excludedConditions;
+      std::optional<TimedCondition> convexHull;
+      for (std::size_t i = 0; i < simpleLanguages.size(); ++i) {
+        const TimedCondition &condition = simpleLanguages.at(i).getTimedCondition();
+        if (included.at(i)) {
+          if (convexHull) {
+            convexHull->convexHullAssign(condition);
+          } else {
+            convexHull = condition;
+          }
+          includedConditions.push_back(condition);
+        } else {
+          excludedConditions.push_back(condition);
+        }
+      }
+
+      // Simplify the result
+      if (includedConditions.empty()) {
+        return TimedConditionSet::bottom();
+      } else if (excludedConditions.empty()) {
+        return TimedConditionSet{elementary.getTimedCondition()};
+      } else if (TimedConditionSet::isExactConvexHull(*convexHull, includedConditions.size(),
+                                                      includedConditions, excludedConditions)) {
+        // When the convex hull is the exact union
+        return TimedConditionSet{*convexHull};
+      } else {
+        // When the convex hull is an overapproximation
+        return TimedConditionSet::reduce(includedConditions, excludedConditions);
+      }
     }
 
   public:
-    explicit SymbolicMembershipOracle(std::unique_ptr<SUL>&& sul) : membershipOracle(
-            std::make_unique<MembershipOracleCache>(std::make_unique<SULMembershipOracle>(std::move(sul)))) {}
+    /*!
+     * @param symbolicCapacity The capacity of the caches of the symbolic membership queries and of the simple elementary
+     * languages. 0 means unbounded.
+     * @param concreteCapacity The capacity of the cache of the membership queries. 0 means unbounded.
+     */
+    explicit SymbolicMembershipOracle(std::unique_ptr<SUL>&& sul, std::size_t symbolicCapacity = 0,
+                                      std::size_t concreteCapacity = 0) : membershipOracle(
+            std::make_unique<MembershipOracleCache>(std::make_unique<SULMembershipOracle>(std::move(sul)),
+                                                    concreteCapacity)), cache(symbolicCapacity),
+            simpleCache(symbolicCapacity) {}
+
+    /*!
+     * @brief Construct the symbolic membership oracle from a membership oracle, e.g., ParallelMembershipOracle
+     */
+    explicit SymbolicMembershipOracle(std::unique_ptr<MembershipOracle> &&oracle, std::size_t symbolicCapacity = 0,
+                                      std::size_t concreteCapacity = 0) : membershipOracle(
+            std::make_unique<MembershipOracleCache>(std::move(oracle), concreteCapacity)), cache(symbolicCapacity),
+            simpleCache(symbolicCapacity) {}
+
+    /*!
+     * @brief Persist the answers of the membership queries to the given file and reuse the answers in it
+     *
+     * The persistent layer is put below the cache of the membership queries so that the answers are kept in memory only
+     * by the bounded cache.
+     *
+     * @sa PersistentMembershipOracle
+     */
+    void persist(const std::filesystem::path &path, std::uint64_t targetFingerprint) {
+      this->membershipOracle->wrapOracle([&](std::unique_ptr<MembershipOracle> oracle) {
+        return std::make_unique<PersistentMembershipOracle>(std::move(oracle), path, targetFingerprint);
+      });
+    }
 
     /*!
      * @brief Make a symbolic membership query
@@ -35,43 +118,106 @@ namespace learnta {
      * @returns A list representing the resulting timed conditions
      */
     TimedConditionSet query(const ElementaryLanguage &elementary) {
-      ++countSymbolic;
-      auto it = cache.find(elementary);
-      if (it != cache.end()) {
-        return it->second;
-      }
-      ++countSymbolicWithCache;
-      std::list<ElementaryLanguage> includedLanguages;
-      bool allIncluded = true;
-      // Check if each of the simple elementary language is in the target language
-      for (const auto &simple: elementary.enumerate()) {
-        if (this->included(simple)) {
-          includedLanguages.push_back(simple);
+      return std::move(this->queries({elementary}).front());
+    }
+
+    /*!
+     * @brief Make symbolic membership queries as a batch
+     *
+     * The simple elementary languages of all the queries not in the cache are asked to the membership oracle as a single
+     * batch. If a thread pool is given, the enumeration and sampling of the simple elementary languages and the
+     * construction of the results are done concurrently. The caches are updated only by the calling thread.
+     *
+     * @param pool The thread pool to use. If it is nullptr, everything is done sequentially.
+     * @returns The results of the queries in the same order as the given elementary languages
+     */
+    std::vector<TimedConditionSet> queries(const std::vector<ElementaryLanguage> &elementaryLanguages,
+                                           ThreadPool *pool = nullptr) {
+      const auto forEachIndex = [&](std::size_t n, const ThreadPool::Task &task) {
+        if (pool) {
+          pool->parallelFor(n, task);
         } else {
-          allIncluded = false;
+          for (std::size_t i = 0; i < n; ++i) {
+            task(i, 0);
+          }
+        }
+      };
+      countSymbolic += elementaryLanguages.size();
+      std::vector<TimedConditionSet> results(elementaryLanguages.size());
+      // The queries not in the cache. We make the same query only once.
+      std::vector<std::size_t> missedIndices;
+      boost::unordered_map<ElementaryLanguage, std::size_t> missedPositions;
+      // The positions in missedIndices for each of the queries
+      std::vector<std::optional<std::size_t>> positions(elementaryLanguages.size());
+      for (std::size_t i = 0; i < elementaryLanguages.size(); ++i) {
+        if (const TimedConditionSet *cached = cache.find(elementaryLanguages.at(i))) {
+          results.at(i) = *cached;
+          continue;
+        }
+        auto it = missedPositions.find(elementaryLanguages.at(i));
+        if (it == missedPositions.end()) {
+          positions.at(i) = missedIndices.size();
+          missedPositions.emplace(elementaryLanguages.at(i), missedIndices.size());
+          missedIndices.push_back(i);
+        } else {
+          positions.at(i) = it->second;
         }
       }
+      countSymbolicWithCache += missedIndices.size();
+      if (missedIndices.empty()) {
+        return results;
+      }
 
-      // Simplify the result
-      if (includedLanguages.empty()) {
-        cache[elementary] = TimedConditionSet::bottom();
-        return cache[elementary];
-      } else if (allIncluded) {
-        cache[elementary] = TimedConditionSet{elementary.getTimedCondition()};
-        return cache[elementary];
-      } else {
-        auto convexHull = ElementaryLanguage::convexHull(includedLanguages);
-        // Check if the convex hull is the exact union.
-        if (convexHull.enumerate().size() == includedLanguages.size()) {
-          // When the convex hull is the exact union
-          cache[elementary] = TimedConditionSet{convexHull.getTimedCondition()};
-          return cache[elementary];
-        } else {
-          // When the convex hull is an overapproximation
-          cache[elementary] = TimedConditionSet::reduce(std::move(includedLanguages));
-          return cache[elementary];
+      // Enumerate the simple elementary languages in each query. We use the breadth-first order of enumerate() because
+      // TimedConditionSet::reduce depends on the order of its input.
+      std::vector<std::vector<ElementaryLanguage>> simpleLanguages(missedIndices.size());
+      forEachIndex(missedIndices.size(), [&](std::size_t i, std::size_t) {
+        simpleLanguages.at(i) = elementaryLanguages.at(missedIndices.at(i)).enumerate();
+      });
+
+      // Check if each of the simple elementary language is in the target language.
+      // We make the queries not in the cache as a batch.
+      std::vector<std::vector<char>> included(missedIndices.size());
+      std::vector<std::pair<std::size_t, std::size_t>> missedSimples;
+      for (std::size_t i = 0; i < missedIndices.size(); ++i) {
+        included.at(i).resize(simpleLanguages.at(i).size());
+        for (std::size_t j = 0; j < simpleLanguages.at(i).size(); ++j) {
+          if (const bool *cached = simpleCache.find(simpleLanguages.at(i).at(j))) {
+            included.at(i).at(j) = *cached;
+          } else {
+            missedSimples.emplace_back(i, j);
+          }
+        }
+      }
+      if (!missedSimples.empty()) {
+        std::vector<TimedWord> samples(missedSimples.size());
+        forEachIndex(missedSimples.size(), [&](std::size_t k, std::size_t) {
+          samples.at(k) = simpleLanguages.at(missedSimples.at(k).first).at(missedSimples.at(k).second).sample();
+        });
+        const auto answers = this->membershipOracle->answerQueries(samples);
+        for (std::size_t k = 0; k < missedSimples.size(); ++k) {
+          const auto [i, j] = missedSimples.at(k);
+          included.at(i).at(j) = answers.at(k);
+          simpleCache.insert(simpleLanguages.at(i).at(j), answers.at(k));
         }
       }
+
+      // Construct the results
+      std::vector<TimedConditionSet> missedResults(missedIndices.size());
+      forEachIndex(missedIndices.size(), [&](std::size_t i, std::size_t) {
+        missedResults.at(i) = simplify(elementaryLanguages.at(missedIndices.at(i)), simpleLanguages.at(i),
+                                       included.at(i));
+      });
+      for (std::size_t i = 0; i < missedIndices.size(); ++i) {
+        cache.insert(elementaryLanguages.at(missedIndices.at(i)), missedResults.at(i));
+      }
+      for (std::size_t i = 0; i < elementaryLanguages.size(); ++i) {
+        if (positions.at(i)) {
+          results.at(i) = missedResults.at(*positions.at(i));
+        }
+      }
+
+      return results;
     }
 
     [[nodiscard]] std::size_t count() const override {
@@ -82,9 +228,15 @@ namespace learnta {
       return this->membershipOracle->answerQuery(timedWord);
     }
 
+    std::vector<bool> answerQueries(const std::vector<TimedWord> &timedWords) override {
+      return this->membershipOracle->answerQueries(timedWords);
+    }
+
     std::ostream &printStatistics(std::ostream &stream) const override {
       stream << "Number of symbolic membership queries: " << countSymbolic << "\n";
       stream << "Number of symbolic membership queries (with cache): " << countSymbolicWithCache << "\n";
+      cache.printStatistics(stream, "symbolic membership query cache");
+      simpleCache.printStatistics(stream, "simple elementary language cache");
       return this->membershipOracle->printStatistics(stream);
     }
   };
@@ -11,7 +11,12 @@ namespace learnta {
   @tparam NVar the number of variable in TA
 
   TA to ZA adds states with BFS. Initial configuration is the initial states of
-  ZA. The ZA contain only the states reachable from initial states.
+  ZA. The ZA contain only the states reachable from initial states. The zones are abstracted by the Extra+_LU
+  extrapolation with the bounds of each location computed by TimedAutomaton::makeLUBounds.
+
+  @param usePackedZones If it is true, all the constants in TA are integers at most maxPackedConstant in the absolute
+  value, and the TA has less than maxPackedDimension clock variables, we explore the zones with PackedZone. If the TA
+  has at most maxFixedPackedZoneDimension - 1 clock variables, the zones are of a fixed size.
  */
-  void ta2za(const TimedAutomaton &TA, ZoneAutomaton &ZA, bool quickReturn = true);
+  void ta2za(const TimedAutomaton &TA, ZoneAutomaton &ZA, bool quickReturn = true, bool usePackedZones = true);
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace learnta {
+  /*!
+   * @brief Read-only view of a contiguous sequence, e.g., a row of TableStorage or a vector
+   *
+   * @note The view is invalidated when the underlying storage is resized.
+   */
+  template<class T>
+  class RowView {
+  private:
+    const T *first = nullptr;
+    std::size_t length = 0;
+
+  public:
+    RowView() = default;
+
+    RowView(const T *first, std::size_t length) : first(first), length(length) {}
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    RowView(const std::vector<T> &vector) : first(vector.data()), length(vector.size()) {}
+
+    [[nodiscard]] std::size_t size() const {
+      return length;
+    }
+
+    [[nodiscard]] bool empty() const {
+      return length == 0;
+    }
+
+    const T &at(std::size_t i) const {
+      if (i >= length) {
+        throw std::out_of_range("RowView::at");
+      }
+      return first[i];
+    }
+
+    const T &operator[](std::size_t i) const {
+      return first[i];
+    }
+
+    const T &front() const {
+      return first[0];
+    }
+
+    const T &back() const {
+      return first[length - 1];
+    }
+
+    const T *begin() const {
+      return first;
+    }
+
+    const T *end() const {
+      return first + length;
+    }
+
+    //! @brief Copy the elements to a vector, e.g., to append an element
+    [[nodiscard]] std::vector<T> toVector() const {
+      return std::vector<T>(begin(), end());
+    }
+  };
+
+  /*!
+   * @brief Two-dimensional table of cells stored contiguously in the row-major order
+   *
+   * Each row occupies a slot of the same width, and the width is doubled when we add a column beyond it. Therefore,
+   * adding a column usually requires no reallocation, and the cells of a row are adjacent in memory. The coordinate
+   * (i, j) of a cell never changes.
+   */
+  template<class T>
+  class TableStorage {
+  private:
+    std::vector<T> cells;
+    std::size_t numRows = 0;
+    std::size_t numColumns = 0;
+    //! @brief The distance between the first cells of two adjacent rows
+    std::size_t stride = 0;
+
+  public:
+    [[nodiscard]] std::size_t rows() const {
+      return numRows;
+    }
+
+    [[nodiscard]] std::size_t columns() const {
+      return numColumns;
+    }
+
+    /*!
+     * @brief Resize the table keeping the existing cells. The new cells are default-constructed.
+     */
+    void resize(std::size_t newRows, std::size_t newColumns) {
+      if (newColumns > stride) {
+        // Relocate the rows to the wider slots
+        const std::size_t newStride = std::max(newColumns, 2 * stride);
+        std::vector<T> newCells(newRows * newStride);
+        for (std::size_t i = 0; i < std::min(numRows, newRows); ++i) {
+          std::move(cells.begin() + i * stride, cells.begin() + i * stride + numColumns,
+                    newCells.begin() + i * newStride);
+        }
+        cells = std::move(newCells);
+        stride = newStride;
+      } else {
+        if (newColumns < numColumns) {
+          // Reset the removed cells so that they are default-constructed when the columns are added again
+          for (std::size_t i = 0; i < std::min(numRows, newRows); ++i) {
+            std::fill(cells.begin() + i * stride + newColumns, cells.begin() + i * stride + numColumns, T{});
+          }
+        }
+        cells.resize(newRows * stride);
+      }
+      numRows = newRows;
+      numColumns = newColumns;
+    }
+
+    /*!
+     * @brief Remove the j-th column. The columns on the right of it are shifted to the left.
+     */
+    void eraseColumn(std::size_t j) {
+      if (j >= numColumns) {
+        throw std::out_of_range("TableStorage::eraseColumn");
+      }
+      for (std::size_t i = 0; i < numRows; ++i) {
+        const auto rowBegin = cells.begin() + i * stride;
+        std::move(rowBegin + j + 1, rowBegin + numColumns, rowBegin + j);
+        *(rowBegin + numColumns - 1) = T{};
+      }
+      --numColumns;
+    }
+
+    T &at(std::size_t i, std::size_t j) {
+      assert(i < numRows && j < numColumns);
+      return cells.at(i * stride + j);
+    }
+
+    const T &at(std::size_t i, std::size_t j) const {
+      assert(i < numRows && j < numColumns);
+      return cells.at(i * stride + j);
+    }
+
+    //! @brief The view of the i-th row
+    [[nodiscard]] RowView<T> row(std::size_t i) const {
+      if (i >= numRows) {
+        throw std::out_of_range("TableStorage::row");
+      }
+      return RowView<T>{cells.data() + i * stride, numColumns};
+    }
+  };
+}
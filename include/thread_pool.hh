@@ -0,0 +1,178 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace learnta {
+  /*!
+   * @brief A pool of persistent worker threads to run data-parallel loops
+   *
+   * The calling thread also works as the worker 0, and the pool of size \f$n\f$ spawns \f$n - 1\f$ threads. The indices
+   * of a loop are claimed one by one from a shared atomic counter, so an idle worker always picks up the next remaining
+   * task, which balances the load even if the cost of each task varies a lot.
+   *
+   * @note parallelFor must not be called concurrently from different threads. A nested call from a task runs sequentially.
+   */
+  class ThreadPool {
+  public:
+    /*!
+     * @brief The task to execute. The arguments are the index of the task and the ID of the worker executing it.
+     */
+    using Task = std::function<void(std::size_t, std::size_t)>;
+
+  private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable finishCondition;
+    const Task *task = nullptr;
+    std::size_t numTasks = 0;
+    std::atomic<std::size_t> nextTask{0};
+    //! @brief Incremented each time we start a loop so that the workers can notice it
+    std::size_t generation = 0;
+    //! @brief The number of worker threads still working on the current loop
+    std::size_t numRunning = 0;
+    std::exception_ptr exception;
+    bool stopping = false;
+
+    //! @brief The pool the current thread is working for, if any, and the worker ID in it
+    static std::pair<ThreadPool *, std::size_t> &currentWorker() {
+      static thread_local std::pair<ThreadPool *, std::size_t> worker{nullptr, 0};
+      return worker;
+    }
+
+    //! @brief Execute the tasks of the current loop until no task remains
+    void work(std::size_t workerId) {
+      for (std::size_t index = nextTask++; index < numTasks; index = nextTask++) {
+        try {
+          (*task)(index, workerId);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock{mutex};
+          if (!exception) {
+            exception = std::current_exception();
+          }
+          // Skip the remaining tasks
+          nextTask = numTasks;
+        }
+      }
+    }
+
+    void workerLoop(std::size_t workerId) {
+      currentWorker() = {this, workerId};
+      std::size_t seenGeneration = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock{mutex};
+          startCondition.wait(lock, [&] {
+            return stopping || generation != seenGeneration;
+          });
+          if (stopping) {
+            return;
+          }
+          seenGeneration = generation;
+        }
+        work(workerId);
+        {
+          std::lock_guard<std::mutex> lock{mutex};
+          if (--numRunning == 0) {
+            finishCondition.notify_one();
+          }
+        }
+      }
+    }
+
+  public:
+    /*!
+     * @param size The number of workers including the calling thread. If it is 0, we use the hardware concurrency.
+     */
+    explicit ThreadPool(std::size_t size) {
+      if (size == 0) {
+        size = std::max(1u, std::thread::hardware_concurrency());
+      }
+      threads.reserve(size - 1);
+      for (std::size_t workerId = 1; workerId < size; ++workerId) {
+        threads.emplace_back([this, workerId] {
+          this->workerLoop(workerId);
+        });
+      }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+      }
+      startCondition.notify_all();
+      for (auto &thread: threads) {
+        thread.join();
+      }
+    }
+
+    //! @brief The number of workers including the calling thread
+    [[nodiscard]] std::size_t size() const {
+      return threads.size() + 1;
+    }
+
+    /*!
+     * @brief Execute f(i, workerId) for each \f$i \in \{0, 1, \dots, n - 1\}\f$ and wait for all of them
+     *
+     * The worker ID is less than size(), and no two tasks with the same worker ID run at the same time. If some of the
+     * tasks throw an exception, the remaining tasks are skipped and one of the exceptions is rethrown.
+     */
+    void parallelFor(std::size_t n, const Task &f) {
+      if (currentWorker().first == this) {
+        // Nested call from a task. We run it sequentially on the current worker.
+        const std::size_t workerId = currentWorker().second;
+        for (std::size_t i = 0; i < n; ++i) {
+          f(i, workerId);
+        }
+        return;
+      }
+      if (threads.empty() || n <= 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+          f(i, 0);
+        }
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        task = &f;
+        numTasks = n;
+        nextTask = 0;
+        exception = nullptr;
+        numRunning = threads.size();
+        ++generation;
+      }
+      startCondition.notify_all();
+      currentWorker() = {this, 0};
+      work(0);
+      currentWorker() = {nullptr, 0};
+      std::exception_ptr thrown;
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        finishCondition.wait(lock, [&] {
+          return numRunning == 0;
+        });
+        task = nullptr;
+        thrown = exception;
+      }
+      if (thrown) {
+        std::rethrow_exception(thrown);
+      }
+    }
+  };
+}
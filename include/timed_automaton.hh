@@ -207,6 +207,18 @@ namespace learnta {
     return boost::hash_value(std::make_tuple(transition.target, transition.resetVars, transition.guard));
   }
 
+  /*!
+   * @brief The lower and upper bounds of the clock variables at a location used in the LU extrapolation
+   *
+   * @sa TimedAutomaton::makeLUBounds, Zone::extrapolateLU
+   */
+  struct LUBounds {
+    //! @brief The largest constant c in the relevant lower-bound guards x > c or x >= c for each clock variable
+    std::vector<int> lowerBounds;
+    //! @brief The largest constant c in the relevant upper-bound guards x < c or x <= c for each clock variable
+    std::vector<int> upperBounds;
+  };
+
   /*!
    * @brief A timed automaton
    */
@@ -657,6 +669,20 @@ namespace learnta {
       return maxConstants;
     }
 
+    /*!
+     * @brief Compute the lower and upper bounds of the clock variables at each location by static analysis
+     *
+     * The bounds at a location are the largest constants in the guards of its outgoing transitions, and those at the
+     * targets propagated backward through the transitions. A bound of a clock variable at the target is propagated to
+     * the same clock variable if it is not reset, and to the renamed one if it is renamed. A clock variable assigned a
+     * constant starts afresh, and its bound at the target is not propagated. A target not in states is given
+     * maxConstraints as its bounds, as in ta2za. As in makeMaxConstants, the bound of a clock variable without any
+     * relevant guard is 0. It is finer, i.e., abstracts less, than the -infinity of the paper, but it is still sound.
+     *
+     * See [Behrmann+, STTT'06] for the detail.
+     */
+    [[nodiscard]] std::unordered_map<const TAState *, LUBounds> makeLUBounds() const;
+
     [[nodiscard]] bool deterministic() const {
       return std::all_of(this->states.begin(), this->states.end(), std::mem_fn(&TAState::deterministic));
     }
@@ -20,9 +20,18 @@ namespace learnta {
    * @invariant this->clockValuation.size() == this->automaton.maxConstraints.size();
    */
   class TimedAutomatonRunner : public SUL {
+    //! @brief Snapshot of the configuration of TimedAutomatonRunner
+    struct RunnerState : public SULState {
+      TAState *state;
+      std::vector<double> clockValuation;
+
+      RunnerState(TAState *state, std::vector<double> clockValuation) : state(state),
+                                                                         clockValuation(std::move(clockValuation)) {}
+    };
+
   private:
     TimedAutomaton automaton;
-    TAState *state;
+    TAState *state = nullptr;
     std::vector<double> clockValuation;
     std::size_t numQueries;
     const bool isEmpty = false;
@@ -86,7 +95,13 @@ namespace learnta {
       if (this->state == nullptr) {
         return false;
       }
-      for (const TATransition &transition: this->state->next[action]) {
+      // We do not use operator[] because the automaton may be shared with the clones running in the other threads
+      const auto it = this->state->next.find(action);
+      if (it == this->state->next.end()) {
+        state = nullptr;
+        return false;
+      }
+      for (const TATransition &transition: it->second) {
         // Check if the guard is satisfied
         if (std::all_of(transition.guard.begin(), transition.guard.end(), [&](const Constraint &guard) {
           return guard.satisfy(this->clockValuation.at(guard.x));
@@ -163,5 +178,47 @@ namespace learnta {
     [[nodiscard]] std::size_t count() const override {
       return numQueries;
     }
+
+    /*!
+     * @brief Check if the current location is a rejecting sink
+     *
+     * A location is a rejecting sink if it is not accepting and all of its outgoing transitions are self loops.
+     */
+    [[nodiscard]] bool inRejectingSink() const override {
+      if (isEmpty || this->state == nullptr) {
+        return true;
+      }
+      if (this->state->isMatch) {
+        return false;
+      }
+      return std::all_of(this->state->next.begin(), this->state->next.end(), [&](const auto &pair) {
+        return std::all_of(pair.second.begin(), pair.second.end(), [&](const TATransition &transition) {
+          return transition.target == this->state;
+        });
+      });
+    }
+
+    [[nodiscard]] std::unique_ptr<SULState> save() const override {
+      return std::make_unique<RunnerState>(this->state, this->clockValuation);
+    }
+
+    void restore(const SULState &snapshot) override {
+      const auto &runnerState = dynamic_cast<const RunnerState &>(snapshot);
+      this->state = runnerState.state;
+      this->clockValuation = runnerState.clockValuation;
+    }
+
+    void countSharedQueries(std::size_t n) override {
+      numQueries += n;
+    }
+
+    /*!
+     * @brief Make a fresh runner of the same timed automaton
+     *
+     * @note The states of the timed automaton are shared with the clone. It is safe because we never modify them.
+     */
+    [[nodiscard]] std::unique_ptr<SUL> clone() const override {
+      return std::make_unique<TimedAutomatonRunner>(this->automaton);
+    }
   };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <utility>
+#include <tuple>
 #include <deque>
 #include <iostream>
 
@@ -285,6 +286,54 @@ namespace learnta {
       return TimedCondition{Zone{this->zone.value.cwiseMax(condition.zone.value)}};
     }
 
+  private:
+    /*!
+     * @brief Feed each simple timed condition to the callback refining the constraints from \f$\tau_i + \dots + \tau_j\f$
+     *
+     * @pre this is not simple
+     */
+    template<class Callback>
+    bool forEachSimple(std::size_t i, std::size_t j, Callback &callback) const {
+      // Skip the constraints we do not have to refine
+      while (i < this->size()) {
+        const auto lowerBound = this->getLowerBound(i, j);
+        const auto upperBound = this->getUpperBound(i, j);
+        if (!learnta::isPoint(upperBound, lowerBound) && !isUnitOpen(upperBound, lowerBound)) {
+          break;
+        }
+        std::tie(i, j) = (j + 1 < this->size()) ? std::make_pair(i, j + 1) : std::make_pair(i + 1, i + 1);
+      }
+      if (i >= this->size()) {
+        return true;
+      }
+      const auto [nextI, nextJ] = (j + 1 < this->size()) ? std::make_pair(i, j + 1) : std::make_pair(i + 1, i + 1);
+      auto lowerBound = this->getLowerBound(i, j);
+      const auto upperBound = this->getUpperBound(i, j);
+      Bounds currentUpperBound = lowerBound.second ? -lowerBound : std::make_pair(-lowerBound.first + 1, false);
+      while (currentUpperBound <= upperBound) {
+        auto currentTimedCondition = *this;
+        currentTimedCondition.restrictLowerBound(i, j, lowerBound, false);
+        currentTimedCondition.restrictUpperBound(i, j, currentUpperBound, false);
+        if (lowerBound.second) {
+          currentUpperBound = {-lowerBound.first + 1, false};
+          lowerBound.second = false;
+        } else {
+          currentUpperBound = std::make_pair(-lowerBound.first + 1, true);
+          lowerBound = {lowerBound.first - 1, true};
+        }
+        if (currentTimedCondition.isSimple()) {
+          if (!callback(std::as_const(currentTimedCondition))) {
+            return false;
+          }
+        } else if (!currentTimedCondition.forEachSimple(nextI, nextJ, callback)) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+  public:
     /*!
      * @brief Make a vector of simple timed conditions in this timed condition
      *
@@ -361,6 +410,26 @@ namespace learnta {
       return simpleConditions;
     }
 
+    /*!
+     * @brief Feed each simple timed condition in this timed condition to the callback
+     *
+     * The simple timed conditions are the same as enumerate(), but they are generated one by one in the depth-first
+     * order without materializing them, and we can stop the enumeration by returning false from the callback. Since the
+     * order differs from enumerate(), use enumerate() if the result depends on the order, e.g., in
+     * TimedConditionSet::reduce.
+     *
+     * @param callback A function taking a simple timed condition and returning false to stop the enumeration
+     * @returns false if and only if the enumeration is stopped by the callback
+     * @pre zone is canonical
+     */
+    template<class Callback>
+    bool forEachSimple(Callback &&callback) const {
+      if (this->isSimple()) {
+        return callback(*this);
+      }
+      return this->forEachSimple(0, 0, callback);
+    }
+
     /*!
      * @brief Make a continuous successor by elapsing variables
      */
@@ -779,6 +848,16 @@ namespace learnta {
       return learnta::hash_value(this->zone);
     }
 
+    //! @brief Write the timed condition in the binary format
+    void save(BinaryWriter &writer) const {
+      this->zone.save(writer);
+    }
+
+    //! @brief Read the timed condition written by save
+    static TimedCondition load(BinaryReader &reader) {
+      return TimedCondition{Zone::load(reader)};
+    }
+
     std::ostream &print(std::ostream &os) const {
       for (std::size_t i = 0; i < this->size(); ++i) {
         for (std::size_t j = i; j < this->size(); ++j) {
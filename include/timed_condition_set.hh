@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <list>
 #include <vector>
 #include <utility>
 
@@ -57,6 +60,68 @@ namespace learnta {
                      [&](auto &&elementary) {
                        return std::make_pair(elementary.getTimedCondition(), 1);
                      });
+
+      return reduce(std::move(timedConditionsWithSize), [](const TimedCondition &convexHull, std::size_t size) {
+        // We stop the enumeration once we find too many simple conditions
+        std::size_t count = 0;
+        return convexHull.forEachSimple([&](const TimedCondition &) {
+          return ++count <= size;
+        }) && count == size;
+      });
+    }
+
+    /*!
+     * @brief Construct a timed condition set from the simple timed conditions partitioning a timed condition
+     *
+     * This gives the same result as the reduction of the included simple conditions, but we check if a convex hull is
+     * the exact union by the inclusion of the simple conditions rather than enumerating the simple conditions in it.
+     * This is valid because any simple condition in the partition is either included in or disjoint from the convex
+     * hull of some of them.
+     *
+     * @param included The simple timed conditions in the set
+     * @param excluded The other simple timed conditions in the partition
+     * @pre included and excluded are disjoint and their union is the set of the simple conditions of a timed condition
+     */
+    static TimedConditionSet reduce(const std::vector<TimedCondition> &included,
+                                    const std::vector<TimedCondition> &excluded) {
+      std::list<std::pair<TimedCondition, int>> timedConditionsWithSize;
+      std::transform(included.begin(), included.end(), std::back_inserter(timedConditionsWithSize),
+                     [&](const TimedCondition &condition) {
+                       return std::make_pair(condition, 1);
+                     });
+
+      return reduce(std::move(timedConditionsWithSize), [&](const TimedCondition &convexHull, std::size_t size) {
+        return isExactConvexHull(convexHull, size, included, excluded);
+      });
+    }
+
+    /*!
+     * @brief Check if the convex hull of some of the included simple conditions is their exact union
+     *
+     * @param convexHull The convex hull of some of the included simple conditions
+     * @param size The number of the simple conditions used to construct the convex hull
+     * @pre The same as the reduce using included and excluded
+     */
+    static bool isExactConvexHull(const TimedCondition &convexHull, std::size_t size,
+                                  const std::vector<TimedCondition> &included,
+                                  const std::vector<TimedCondition> &excluded) {
+      const auto includes = [&](const TimedCondition &condition) {
+        return convexHull.includes(condition);
+      };
+      return std::none_of(excluded.begin(), excluded.end(), includes) &&
+             static_cast<std::size_t>(std::count_if(included.begin(), included.end(), includes)) == size;
+    }
+
+  private:
+    /*!
+     * @brief Greedily merge the pairs of timed conditions if their convex hull is the exact union
+     *
+     * @param timedConditionsWithSize The timed conditions and the number of the simple conditions in them
+     * @param isExact The function to check if the convex hull is the exact union of the given number of simple conditions
+     */
+    template<class ExactnessChecker>
+    static TimedConditionSet reduce(std::list<std::pair<TimedCondition, int>> timedConditionsWithSize,
+                                    ExactnessChecker isExact) {
       auto it = timedConditionsWithSize.begin();
       while (it != timedConditionsWithSize.end()) {
         auto timedCondition = it->first;
@@ -64,7 +129,7 @@ namespace learnta {
         for (auto it2 = std::next(it); it2 != timedConditionsWithSize.end(); it2++) {
           // Check if the convex hull is the exact union
           auto convexHull = timedCondition.convexHull(it2->first);
-          if (convexHull.enumerate().size() == static_cast<std::size_t>(it->second + it2->second)) {
+          if (isExact(convexHull, static_cast<std::size_t>(it->second + it2->second))) {
             it->first = std::move(convexHull);
             it->second += it2->second;
             timedConditionsWithSize.erase(it2);
@@ -89,6 +154,7 @@ namespace learnta {
       return TimedConditionSet{result};
     }
 
+  public:
     [[nodiscard]] bool empty() const {
       return this->conditions.empty();
     }
@@ -139,6 +205,23 @@ namespace learnta {
       this->conditions.push_back(condition);
     }
 
+    //! @brief Write the timed conditions in the binary format
+    void save(BinaryWriter &writer) const {
+      writer.writeSize(this->conditions.size());
+      for (const auto &condition: this->conditions) {
+        condition.save(writer);
+      }
+    }
+
+    //! @brief Read the timed conditions written by save
+    static TimedConditionSet load(BinaryReader &reader) {
+      std::vector<TimedCondition> conditions(reader.readSize());
+      for (auto &condition: conditions) {
+        condition = TimedCondition::load(reader);
+      }
+      return TimedConditionSet{std::move(conditions)};
+    }
+
     TimedCondition& back() {
       return this->conditions.back();
     }
@@ -169,6 +169,10 @@ namespace learnta {
   }
 
   static inline std::size_t hash_value(const TimedWord &word) {
-    return boost::hash_value(std::make_tuple(word.getWord(), word.getDurations()));
+    // The same value as the hash of std::make_tuple(word.getWord(), word.getDurations()) without copying them
+    std::size_t seed = 0;
+    boost::hash_combine(seed, word.getWord());
+    boost::hash_combine(seed, word.getDurations());
+    return seed;
   }
 }
\ No newline at end of file
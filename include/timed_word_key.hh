@@ -0,0 +1,71 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/functional/hash.hpp>
+
+#include "timed_word.hh"
+
+namespace learnta {
+  /*!
+   * @brief Immutable compact representation of a timed word used as a key of hash tables
+   *
+   * The hash value is computed once at the construction, and the comparison first compares the hash values. The actions
+   * and the durations of a short timed word are stored inline without any heap allocation. The hash value is the same as
+   * the one of the timed word, so a hash table of keys can be looked up by a TimedWord without constructing its key.
+   */
+  class TimedWordKey {
+  public:
+    //! @brief The maximum number of the actions stored inline
+    static constexpr std::size_t inlineCapacity = 8;
+
+  private:
+    boost::container::small_vector<char, inlineCapacity> word;
+    boost::container::small_vector<double, inlineCapacity + 1> durations;
+    std::size_t hash;
+
+  public:
+    explicit TimedWordKey(const TimedWord &timedWord) : word(timedWord.getWord().begin(), timedWord.getWord().end()),
+                                                        durations(timedWord.getDurations().begin(),
+                                                                  timedWord.getDurations().end()),
+                                                        hash(hash_value(timedWord)) {}
+
+    //! @brief Reconstruct the timed word
+    [[nodiscard]] TimedWord toTimedWord() const {
+      return TimedWord{std::string(word.begin(), word.end()), std::vector<double>(durations.begin(), durations.end())};
+    }
+
+    [[nodiscard]] std::size_t wordSize() const {
+      return word.size();
+    }
+
+    [[nodiscard]] std::size_t hashValue() const {
+      return hash;
+    }
+
+    bool operator==(const TimedWordKey &another) const {
+      return this->hash == another.hash && this->word == another.word && this->durations == another.durations;
+    }
+
+    bool operator!=(const TimedWordKey &another) const {
+      return !(*this == another);
+    }
+
+    //! @brief Compare with a timed word without constructing its key, e.g., for LRUCache::find
+    bool operator==(const TimedWord &timedWord) const {
+      return std::equal(word.begin(), word.end(), timedWord.getWord().begin(), timedWord.getWord().end()) &&
+             std::equal(durations.begin(), durations.end(), timedWord.getDurations().begin(),
+                        timedWord.getDurations().end());
+    }
+  };
+
+  static inline std::size_t hash_value(const TimedWordKey &key) {
+    return key.hashValue();
+  }
+}
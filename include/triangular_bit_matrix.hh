@@ -0,0 +1,49 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace learnta {
+  /*!
+   * @brief Symmetric binary relation over indices stored as a lower triangular bit matrix
+   *
+   * The pair \f$(i, j)\f$ with \f$j \le i\f$ is stored at the bit \f$i (i + 1) / 2 + j\f$. Since the position does not
+   * depend on the number of indices, the matrix grows just by appending bits.
+   */
+  class TriangularBitMatrix {
+  private:
+    std::vector<bool> bits;
+
+    static std::size_t position(std::size_t i, std::size_t j) {
+      if (i < j) {
+        std::swap(i, j);
+      }
+      return i * (i + 1) / 2 + j;
+    }
+
+  public:
+    //! @brief Add the unordered pair \f$\{i, j\}\f$ to the relation
+    void insert(std::size_t i, std::size_t j) {
+      const auto pos = position(i, j);
+      if (pos >= bits.size()) {
+        bits.resize(pos + 1);
+      }
+      bits[pos] = true;
+    }
+
+    //! @brief Returns if the unordered pair \f$\{i, j\}\f$ is in the relation
+    [[nodiscard]] bool contains(std::size_t i, std::size_t j) const {
+      const auto pos = position(i, j);
+      return pos < bits.size() && bits[pos];
+    }
+
+    void clear() {
+      bits.clear();
+    }
+  };
+}
@@ -10,6 +10,7 @@
 #include "common_types.hh"
 #include "bounds.hh"
 #include "constraint.hh"
+#include "binary_serialization.hh"
 
 #include <Eigen/Core>
 #include <utility>
@@ -69,7 +70,8 @@ namespace learnta {
 
     //! @brief Make the zone of size `size` such that all the values are zero
     static Zone zero(int size) {
-      static Zone zeroZone;
+      // thread_local because the zones are constructed concurrently, e.g., in SymbolicMembershipOracle::queries
+      static thread_local Zone zeroZone;
       if (zeroZone.value.cols() == size) {
         return zeroZone;
       }
@@ -82,7 +84,7 @@ namespace learnta {
      * @brief Make the zone of size `size` with no constraints
      */
     static Zone top(std::size_t size) {
-      static Zone topZone;
+      static thread_local Zone topZone;
       if (static_cast<std::size_t>(topZone.value.cols()) == size) {
         return topZone;
       }
@@ -150,6 +152,68 @@ namespace learnta {
       }
     }
 
+    /*!
+     * @brief Apply the resets to a canonical zone without canonizing it
+     *
+     * Instead of unconstraining the reset variable and canonizing the zone, we directly copy the row and the column of
+     * the renamed variable or of the special variable 0 shifted by the assigned value. Each reset takes \f$O(n)\f$
+     * time instead of \f$O(n^3)\f$.
+     *
+     * @pre The zone is canonical and satisfiable
+     * @post The zone is the same as the one by applyResets followed by canonize, and it is canonical
+     */
+    void applyResetsCanonical(const std::vector<std::pair<ClockVariables, std::variant<double, ClockVariables>>> &resets) {
+      // We apply renaming first
+      for (const auto &[resetVariable, updatedVariable]: resets) {
+        if (updatedVariable.index() == 1 && resetVariable != std::get<ClockVariables>(updatedVariable)) {
+          this->copy(resetVariable, std::get<ClockVariables>(updatedVariable));
+        }
+      }
+      // Then, assign a value
+      for (const auto &[resetVariable, updatedVariable]: resets) {
+        if (updatedVariable.index() == 0) {
+          this->assign(resetVariable, std::get<double>(updatedVariable));
+        }
+      }
+    }
+
+    /*!
+     * @brief Assign the value of the clock variable y to x
+     *
+     * @pre The zone is canonical and satisfiable, and x != y
+     * @post The zone is canonical
+     */
+    void copy(ClockVariables x, ClockVariables y) {
+      // 0 is the special variable here
+      x++;
+      y++;
+      value.row(x) = value.row(y);
+      value.col(x) = value.col(y);
+      value(x, y) = Bounds{0.0, true};
+      value(y, x) = Bounds{0.0, true};
+      value(x, x) = Bounds{0.0, true};
+      value(y, y) = std::min(value(y, y), Bounds{0.0, true});
+    }
+
+    /*!
+     * @brief Assign a constant value to the clock variable x
+     *
+     * @pre The zone is canonical and satisfiable
+     * @post The zone is canonical
+     */
+    void assign(ClockVariables x, double c) {
+      // 0 is the special variable here
+      x++;
+      for (Eigen::Index j = 1; j < value.cols(); ++j) {
+        value(x, j) = Bounds{c, true} + value(0, j);
+        value(j, x) = value(j, 0) + Bounds{-c, true};
+      }
+      value(0, x) = Bounds{-c, true};
+      value(x, 0) = Bounds{c, true};
+      value(x, x) = Bounds{0.0, true};
+      value(0, 0) = std::min(value(0, 0), Bounds{0.0, true});
+    }
+
     /*!
      * @brief Make it the weakest precondition of the reset
      *
@@ -359,7 +423,7 @@ namespace learnta {
      * @brief Extrapolate the zone using the diagonal extrapolation based on maximum constants
      *
      * See [Behrmann+, TACAS'04] for the detail.
-     * @note We are currently using this simple extrapolation for simplicity. If we need more speed, we will consider using more sophisticated methods, e.g., LU extrapolation.
+     * @note ta2za uses extrapolateLU instead, which is coarser and results in fewer zones.
     */
     void extrapolate() {
       static constexpr Bounds infinity = Bounds(std::numeric_limits<double>::max(), false);
@@ -382,6 +446,42 @@ namespace learnta {
       }
     }
 
+    /*!
+     * @brief Extrapolate the zone using the Extra+_LU extrapolation based on the lower and upper bounds
+     *
+     * See [Behrmann+, STTT'06] for the detail. The bounds are usually those of a location computed by
+     * TimedAutomaton::makeLUBounds. Unlike extrapolate, the upper bounds of a clock variable are abstracted with its
+     * lower bound and vice versa, and the conditions are evaluated with the lower bounds of the original zone.
+     *
+     * @param lowerBounds The largest constant c in the lower-bound guards x > c or x >= c relevant to each clock variable
+     * @param upperBounds The largest constant c in the upper-bound guards x < c or x <= c relevant to each clock variable
+     * @post The zone may not be canonical
+     */
+    void extrapolateLU(const std::vector<int> &lowerBounds, const std::vector<int> &upperBounds) {
+      static constexpr Bounds infinity = Bounds(std::numeric_limits<double>::max(), false);
+      assert(lowerBounds.size() == this->getNumOfVar());
+      assert(upperBounds.size() == this->getNumOfVar());
+      // The bounds 0 - x before the extrapolation
+      const Eigen::Matrix<Bounds, 1, Eigen::Dynamic> lower = value.row(0);
+      for (std::size_t i = 0; i < lowerBounds.size(); ++i) {
+        const bool beyondLower = -lower(i + 1).first > lowerBounds.at(i);
+        for (std::size_t j = 0; j <= lowerBounds.size(); ++j) {
+          if (i + 1 == j) {
+            continue;
+          }
+          if (beyondLower || value(i + 1, j).first > lowerBounds.at(i) ||
+              (j > 0 && -lower(j).first > upperBounds.at(j - 1))) {
+            value(i + 1, j) = infinity;
+          }
+        }
+      }
+      for (std::size_t j = 0; j < upperBounds.size(); ++j) {
+        if (-lower(j + 1).first > upperBounds.at(j)) {
+          value(0, j + 1) = Bounds{-upperBounds.at(j), false};
+        }
+      }
+    }
+
     /*!
       @brief make the zone unsatisfiable
     */
@@ -426,6 +526,37 @@ namespace learnta {
       z.value.diagonal() = value.diagonal();
       return value == z.value;
     }
+
+    //! @brief Write the zone in the binary format
+    void save(BinaryWriter &writer) const {
+      writer.writeSize(value.cols());
+      for (Eigen::Index i = 0; i < value.rows(); ++i) {
+        for (Eigen::Index j = 0; j < value.cols(); ++j) {
+          writer.write(value(i, j).first);
+          writer.write(value(i, j).second);
+        }
+      }
+      writer.write(M.first);
+      writer.write(M.second);
+      writer.write(maxConstraints);
+    }
+
+    //! @brief Read the zone written by save
+    static Zone load(BinaryReader &reader) {
+      Zone zone;
+      const auto size = static_cast<Eigen::Index>(reader.readSize());
+      zone.value.resize(size, size);
+      for (Eigen::Index i = 0; i < size; ++i) {
+        for (Eigen::Index j = 0; j < size; ++j) {
+          zone.value(i, j).first = reader.read<double>();
+          zone.value(i, j).second = reader.read<bool>();
+        }
+      }
+      zone.M.first = reader.read<double>();
+      zone.M.second = reader.read<bool>();
+      zone.maxConstraints = reader.readVector<double>();
+      return zone;
+    }
   };
 
   //! @brief Print the zone
@@ -445,19 +576,25 @@ namespace learnta {
     return learnta::print(os, zone);
   }
 
-  inline std::size_t hash_value(learnta::Zone const &zone) {
-    std::size_t seed = zone.value.array().size();
-    const auto asVector = zone.value.array();
-
+  //! @brief Combine the hash value of a bound of a DBM to the seed
+  inline void hashCombineBounds(std::size_t &seed, const Bounds &bound) {
     union DI {
       double asD;
       uint64_t asI;
     };
 
+    DI value{};
+    // Adding 0.0 maps -0.0 to 0.0 so that the equal bounds have the same hash value
+    value.asD = bound.first + 0.0;
+    seed ^= bound.second + value.asI + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+  inline std::size_t hash_value(learnta::Zone const &zone) {
+    std::size_t seed = zone.value.array().size();
+    const auto asVector = zone.value.array();
+
     for (auto it = asVector.data(); it != asVector.data() + asVector.size(); it++) {
-      DI value{};
-      value.asD = it->first;
-      seed ^= it->second + value.asI + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      hashCombineBounds(seed, *it);
     }
     return seed;
   }
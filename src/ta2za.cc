@@ -2,8 +2,173 @@
 #include <utility>
 
 #include "../include/ta2za.hh"
+#include "../include/packed_zone.hh"
 
 namespace learnta {
+  namespace {
+    void fillDiagonalWithZero(Zone &zone) {
+      zone.value.diagonal().fill(Bounds{0, true});
+    }
+
+    template<int Dimension>
+    void fillDiagonalWithZero(BasicPackedZone<Dimension> &zone) {
+      zone.value.diagonal().fill(packBounds(0, true));
+    }
+
+    const Zone &toZone(const Zone &zone) {
+      return zone;
+    }
+
+    template<int Dimension>
+    Zone toZone(const BasicPackedZone<Dimension> &zone) {
+      return zone.toZone();
+    }
+
+    //! @brief Returns if the zones of the timed automaton can be represented by PackedZone
+    bool hasIntegralConstants(const TimedAutomaton &TA) {
+      if (TA.clockSize() + 1 > static_cast<std::size_t>(maxPackedDimension)) {
+        return false;
+      }
+      if (std::any_of(TA.maxConstraints.begin(), TA.maxConstraints.end(), [](int maxConstraint) {
+        return std::abs(maxConstraint) > maxPackedConstant;
+      })) {
+        return false;
+      }
+      return std::all_of(TA.states.begin(), TA.states.end(), [](const auto &state) {
+        return std::all_of(state->next.begin(), state->next.end(), [](const auto &pair) {
+          return std::all_of(pair.second.begin(), pair.second.end(), [](const TATransition &transition) {
+            return PackedZone::isIntegral(transition.resetVars) &&
+                   std::all_of(transition.guard.begin(), transition.guard.end(), [](const Constraint &constraint) {
+                     return std::abs(constraint.c) <= maxPackedConstant;
+                   });
+          });
+        });
+      });
+    }
+
+    /*!
+     * @brief Construct the zone automaton by BFS with the given representation of zones
+     *
+     * The zones are explored with ZoneType and stored in the ZAStates as Zone. Each new zone is extrapolated with the
+     * LU bounds of its location.
+     */
+    template<class ZoneType>
+    void ta2zaImpl(const TimedAutomaton &TA, ZoneAutomaton &ZA, bool quickReturn,
+                   const std::unordered_map<const TAState *, LUBounds> &luBounds, const ZoneType &initialZone) {
+      /*!
+        @brief Make initial state, that is Current configuration of BFS
+      */
+      std::deque<std::pair<std::shared_ptr<ZAState>, ZoneType>> newStates;
+      ZA.initialStates.resize(TA.initialStates.size());
+      std::transform(TA.initialStates.begin(), TA.initialStates.end(), ZA.initialStates.begin(),
+                     [&initialZone](const auto &state) {
+                       return std::make_shared<ZAState>(state.get(), toZone(initialZone));
+                     });
+      ZA.states.resize(ZA.initialStates.size());
+      std::copy(ZA.initialStates.begin(), ZA.initialStates.end(), ZA.states.begin());
+      for (const auto &state: ZA.initialStates) {
+        newStates.emplace_back(state, initialZone);
+      }
+
+      /*!
+        @brief translater from TAState and Zone to its corresponding state in ZA.
+
+        The type is like this.
+        (TAState,Zone) -> ZAState
+      */
+      boost::unordered_map<std::pair<TAState *, ZoneType>, std::shared_ptr<ZAState>> zaMap;
+      for (const auto &state: ZA.initialStates) {
+        zaMap[std::make_pair(state->taState, initialZone)] = state;
+      }
+      // The bounds of a target not in TA.states. makeLUBounds also uses them for such a target.
+      const LUBounds globalBounds{TA.maxConstraints, TA.maxConstraints};
+      while (!newStates.empty()) {
+        const auto [zaState, zone] = newStates.front();
+        newStates.pop_front();
+        TAState *taState = zaState->taState;
+        ZoneType nowZone = zone;
+        nowZone.elapse();
+        // The stored zone may not be canonical due to the extrapolation. We canonize it once here, and the operations
+        // for each edge below keep it canonical.
+        nowZone.canonize();
+        for (const auto &[c, edges]: taState->next) {
+          for (const auto &edge: edges) {
+            ZoneType nextZone = nowZone;
+            auto nextState = edge.target;
+            if (!nextState) {
+              continue;
+            }
+            auto boundsIt = luBounds.find(nextState);
+            const LUBounds &nextBounds = boundsIt == luBounds.end() ? globalBounds : boundsIt->second;
+            // Since nextZone is canonical, tighten closes it in O(n^2) time for each constraint
+            nextZone.tighten(edge.guard);
+
+            if (nextZone.isSatisfiableNoCanonize()) {
+              // The resets keep the zone canonical and satisfiable
+              nextZone.applyResetsCanonical(edge.resetVars);
+              fillDiagonalWithZero(nextZone);
+              if (!quickReturn) {
+                nextZone.extrapolateLU(nextBounds.lowerBounds, nextBounds.upperBounds);
+                fillDiagonalWithZero(nextZone);
+              }
+
+              const auto targetStateInZA = std::find_if(zaMap.begin(), zaMap.end(), [&] (const auto &pair) {
+               // if (quickReturn) {
+                  // Use inclusion for state merging
+                  return pair.first.first == nextState && pair.first.second.includes(nextZone);
+               // } else {
+                  // Use equality
+                //  return pair.first.first == nextState && pair.first.second == nextZone;
+                //}
+              });
+
+              // targetStateInZA is already added
+              if (targetStateInZA != zaMap.end()) {
+                zaState->next[c].emplace_back(edge, targetStateInZA->second);
+              } else {
+                // targetStateInZA is new
+                if (quickReturn) {
+                  nextZone.extrapolateLU(nextBounds.lowerBounds, nextBounds.upperBounds);
+                  nextZone.canonize();
+                  fillDiagonalWithZero(nextZone);
+                }
+                ZA.states.push_back(std::make_shared<ZAState>(nextState, toZone(nextZone)));
+                zaState->next[c].emplace_back(edge, ZA.states.back());
+
+                newStates.emplace_back(ZA.states.back(), nextZone);
+                zaMap[std::make_pair(ZA.states.back()->taState, nextZone)] = ZA.states.back();
+              }
+              // We shortcut the zone construction once we reach an accepting state
+              if (nextState->isMatch) {
+                if (quickReturn && ZA.sampleWithMemo()) {
+                  return;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /*!
+     * @brief Construct the zone automaton with BasicPackedZone of the dimension of the initial zone
+     *
+     * We use the fixed-size BasicPackedZone if the dimension is at most maxFixedPackedZoneDimension.
+     */
+    template<int Dimension = 1>
+    void ta2zaPacked(const TimedAutomaton &TA, ZoneAutomaton &ZA, bool quickReturn,
+                     const std::unordered_map<const TAState *, LUBounds> &luBounds, const Zone &initialZone) {
+      if constexpr (Dimension <= maxFixedPackedZoneDimension) {
+        if (initialZone.value.cols() == Dimension) {
+          ta2zaImpl(TA, ZA, quickReturn, luBounds, BasicPackedZone<Dimension>{initialZone});
+        } else {
+          ta2zaPacked<Dimension + 1>(TA, ZA, quickReturn, luBounds, initialZone);
+        }
+      } else {
+        ta2zaImpl(TA, ZA, quickReturn, luBounds, PackedZone{initialZone});
+      }
+    }
+  }
 
 /*!
   @brief Generate a zone automaton from a timed automaton
@@ -12,7 +177,7 @@ namespace learnta {
   TA to ZA adds states with BFS. Initial configuration is the initial states of
   ZA. The ZA contain only the states reachable from initial states.
  */
-  void ta2za(const TimedAutomaton &TA, ZoneAutomaton &ZA, bool quickReturn) {
+  void ta2za(const TimedAutomaton &TA, ZoneAutomaton &ZA, bool quickReturn, bool usePackedZones) {
     const std::size_t clockSize = TA.clockSize();
     Zone initialZone = Zone::zero(clockSize + 1);
 
@@ -29,91 +194,12 @@ namespace learnta {
       initialZone.M = Bounds(0, true);
     }
 
-    /*!
-      @brief Make initial state, that is Current configuration of BFS
-    */
-    std::deque<std::shared_ptr<ZAState>> newStates;
-    ZA.initialStates.resize(TA.initialStates.size());
-    std::transform(TA.initialStates.begin(), TA.initialStates.end(), ZA.initialStates.begin(),
-                   [&initialZone](const auto &state) {
-                     return std::make_shared<ZAState>(state.get(), initialZone);
-                   });
-    ZA.states.resize(ZA.initialStates.size());
-    std::copy(ZA.initialStates.begin(), ZA.initialStates.end(), ZA.states.begin());
-    std::copy(ZA.initialStates.begin(), ZA.initialStates.end(), std::back_inserter(newStates));
-
-    /*!
-      @brief translater from TAState and Zone to its corresponding state in ZA.
-
-      The type is like this.
-      (TAState,Zone) -> ZAState
-    */
-    boost::unordered_map<std::pair<TAState *, Zone>, std::shared_ptr<ZAState>> zaMap;
-    for (const auto &state: ZA.initialStates) {
-      zaMap[std::make_pair(state->taState, state->zone)] = state;
-    }
-    while (!newStates.empty()) {
-      const auto zaState = newStates.front();
-      newStates.pop_front();
-      TAState *taState = zaState->taState;
-      Zone nowZone = zaState->zone;
-      nowZone.elapse();
-      for (const auto &[c, edges]: taState->next) {
-        for (const auto &edge: edges) {
-          Zone nextZone = nowZone;
-          auto nextState = edge.target;
-          if (!nextState) {
-            continue;
-          }
-          nextZone.tighten(edge.guard);
-
-          if (nextZone) {
-            nextZone.applyResets(edge.resetVars);
-            nextZone.canonize();
-            if (!nextZone.isSatisfiable()) {
-              continue;
-            }
-            nextZone.value.diagonal().fill(Bounds{0, true});
-            if (!quickReturn) {
-              nextZone.extrapolate();
-              nextZone.value.diagonal().fill(Bounds{0, true});
-            }
-
-            const auto targetStateInZA = std::find_if(zaMap.begin(), zaMap.end(), [&] (const auto &pair) {
-             // if (quickReturn) {
-                // Use inclusion for state merging
-                return pair.first.first == nextState && pair.first.second.includes(nextZone);
-             // } else {
-                // Use equality
-              //  return pair.first.first == nextState && pair.first.second == nextZone;
-              //}
-            });
-
-            // targetStateInZA is already added
-            if (targetStateInZA != zaMap.end()) {
-              zaState->next[c].emplace_back(edge, targetStateInZA->second);
-            } else {
-              // targetStateInZA is new
-              if (quickReturn) {
-                nextZone.extrapolate();
-                nextZone.canonize();
-                nextZone.value.diagonal().fill(Bounds{0, true});
-              }
-              ZA.states.push_back(std::make_shared<ZAState>(nextState, nextZone));
-              zaState->next[c].emplace_back(edge, ZA.states.back());
-
-              newStates.push_back(ZA.states.back());
-              zaMap[std::make_pair(ZA.states.back()->taState, ZA.states.back()->zone)] = ZA.states.back();
-            }
-            // We shortcut the zone construction once we reach an accepting state
-            if (nextState->isMatch) {
-              if (quickReturn && ZA.sampleWithMemo()) {
-                return;
-              }
-            }
-          }
-        }
-      }
+    // The per-location bounds give a coarser extrapolation than the global maximum constants
+    const auto luBounds = TA.makeLUBounds();
+    if (usePackedZones && hasIntegralConstants(TA)) {
+      ta2zaPacked(TA, ZA, quickReturn, luBounds, initialZone);
+    } else {
+      ta2zaImpl(TA, ZA, quickReturn, luBounds, initialZone);
     }
   }
 }
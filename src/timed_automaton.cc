@@ -3,6 +3,8 @@
  * @date 2022/09/04.
  */
 
+#include <numeric>
+
 #include <boost/unordered_set.hpp>
 
 #include "timed_automaton.hh"
@@ -48,6 +50,77 @@ namespace learnta {
     }
   }
 
+  std::unordered_map<const TAState *, LUBounds> TimedAutomaton::makeLUBounds() const {
+    const auto clockSize = this->clockSize();
+    std::unordered_map<const TAState *, LUBounds> bounds;
+    bounds.reserve(this->stateSize());
+    // The bounds by the guards of the outgoing transitions
+    for (const auto &state: this->states) {
+      LUBounds &local = bounds[state.get()];
+      local.lowerBounds.assign(clockSize, 0);
+      local.upperBounds.assign(clockSize, 0);
+      for (const auto &[action, transitions]: state->next) {
+        for (const auto &transition: transitions) {
+          for (const auto &guard: transition.guard) {
+            if (guard.isUpperBound()) {
+              local.upperBounds.at(guard.x) = std::max(local.upperBounds.at(guard.x), guard.c);
+            } else {
+              local.lowerBounds.at(guard.x) = std::max(local.lowerBounds.at(guard.x), guard.c);
+            }
+          }
+        }
+      }
+    }
+
+    // The bounds of a target not in the states, which ta2za also uses for such a target
+    const LUBounds globalBounds{this->maxConstraints, this->maxConstraints};
+
+    // Propagate the bounds backward until the fixed point
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (const auto &state: this->states) {
+        LUBounds &local = bounds.at(state.get());
+        for (const auto &[action, transitions]: state->next) {
+          for (const auto &transition: transitions) {
+            auto it = bounds.find(transition.target);
+            const LUBounds &target = it == bounds.end() ? globalBounds : it->second;
+            // The clock variable before the transition whose value is that of each clock variable after it
+            std::vector<std::optional<ClockVariables>> sources(clockSize);
+            std::iota(sources.begin(), sources.end(), ClockVariables{0});
+            // We apply renaming first and then assign a value as in Zone::applyResets
+            for (const auto &[resetVariable, updatedVariable]: transition.resetVars) {
+              if (updatedVariable.index() == 1) {
+                sources.at(resetVariable) = sources.at(std::get<ClockVariables>(updatedVariable));
+              }
+            }
+            for (const auto &[resetVariable, updatedVariable]: transition.resetVars) {
+              if (updatedVariable.index() == 0) {
+                sources.at(resetVariable) = std::nullopt;
+              }
+            }
+            for (std::size_t x = 0; x < clockSize; ++x) {
+              if (!sources.at(x)) {
+                continue;
+              }
+              const auto source = *sources.at(x);
+              if (target.lowerBounds.at(x) > local.lowerBounds.at(source)) {
+                local.lowerBounds.at(source) = target.lowerBounds.at(x);
+                changed = true;
+              }
+              if (target.upperBounds.at(x) > local.upperBounds.at(source)) {
+                local.upperBounds.at(source) = target.upperBounds.at(x);
+                changed = true;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return bounds;
+  }
+
   TimedAutomaton learnta::TimedAutomaton::simplifyWithZones() {
     ZoneAutomaton zoneAutomaton;
     ta2za(*this, zoneAutomaton, false);
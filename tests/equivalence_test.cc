@@ -145,6 +145,71 @@ BOOST_AUTO_TEST_SUITE(EquivalenceTest)
     BOOST_CHECK_EQUAL(1, renamingOpt->front().second);
   }
 
+  BOOST_AUTO_TEST_CASE(findFirstIndexParallel) {
+    ThreadPool pool{4};
+    for (std::size_t repeat = 0; repeat < 20; ++repeat) {
+      BOOST_CHECK_EQUAL(7, findFirstIndex(100, [](std::size_t i) { return i >= 7 && i % 7 == 0; }, &pool));
+    }
+    BOOST_CHECK_EQUAL(100, findFirstIndex(100, [](std::size_t) { return false; }, &pool));
+    BOOST_CHECK_EQUAL(7, findFirstIndex(100, [](std::size_t i) { return i >= 7 && i % 7 == 0; }, nullptr));
+  }
+
+  BOOST_AUTO_TEST_CASE(columnOrder) {
+    ColumnOrder order;
+    BOOST_CHECK((order.columns(3) == std::vector<std::size_t>{0, 1, 2}));
+    // The refuting column is moved to the front
+    order.refute(2);
+    BOOST_CHECK((order.columns(3) == std::vector<std::size_t>{2, 0, 1}));
+    order.refute(1);
+    BOOST_CHECK((order.columns(3) == std::vector<std::size_t>{1, 2, 0}));
+    // The new columns are appended, and the columns out of range are skipped
+    BOOST_CHECK((order.columns(4) == std::vector<std::size_t>{1, 2, 0, 3}));
+    BOOST_CHECK((order.columns(2) == std::vector<std::size_t>{1, 0}));
+    order.clear();
+    BOOST_CHECK((order.columns(2) == std::vector<std::size_t>{0, 1}));
+  }
+
+  BOOST_FIXTURE_TEST_CASE(findDeterministicEquivalenceParallel, Fixture) {
+    const std::vector<BackwardRegionalElementaryLanguage> suffixes = {s1, s2, s3};
+    const std::vector<ForwardRegionalElementaryLanguage> prefixes = {p1, p2, p3, p4, p5, p6, p7, p9, p10, p13};
+    std::vector<std::vector<TimedConditionSet>> rows(prefixes.size());
+    std::vector<std::vector<TimedCondition>> concatenations(prefixes.size());
+    for (std::size_t i = 0; i < prefixes.size(); ++i) {
+      for (const auto &suffix: suffixes) {
+        rows.at(i).push_back(this->oracle->query(prefixes.at(i) + suffix));
+        concatenations.at(i).push_back((prefixes.at(i) + suffix).getTimedCondition());
+      }
+    }
+
+    // The parallel search returns the same witness as the sequential one
+    ThreadPool pool{4};
+    ColumnOrder order;
+    std::size_t numEquivalent = 0;
+    for (std::size_t i = 0; i < prefixes.size(); ++i) {
+      for (std::size_t j = 0; j < prefixes.size(); ++j) {
+        const auto sequential = findDeterministicEquivalentRenaming(prefixes.at(i), rows.at(i), concatenations.at(i),
+                                                                    prefixes.at(j), rows.at(j), concatenations.at(j),
+                                                                    suffixes);
+        const auto parallel = findDeterministicEquivalentRenaming(prefixes.at(i), rows.at(i), concatenations.at(i),
+                                                                  prefixes.at(j), rows.at(j), concatenations.at(j),
+                                                                  suffixes, &pool);
+        // The order of the columns does not change the result
+        const auto ordered = findDeterministicEquivalentRenaming(prefixes.at(i), rows.at(i), concatenations.at(i),
+                                                                 prefixes.at(j), rows.at(j), concatenations.at(j),
+                                                                 suffixes, &pool, &order);
+        BOOST_REQUIRE_EQUAL(sequential.has_value(), parallel.has_value());
+        BOOST_REQUIRE_EQUAL(sequential.has_value(), ordered.has_value());
+        if (sequential) {
+          BOOST_CHECK(*sequential == *parallel);
+          BOOST_CHECK(*sequential == *ordered);
+          ++numEquivalent;
+        }
+      }
+    }
+    // At least, each prefix is equivalent to itself
+    BOOST_CHECK_GE(numEquivalent, prefixes.size());
+  }
+
   BOOST_FIXTURE_TEST_CASE(p13p2s1s2s3Equivalence, Fixture) {
     std::vector<BackwardRegionalElementaryLanguage> suffixes = {s1, s2, s3};
     std::vector<TimedConditionSet> p2Row, p13Row;
@@ -0,0 +1,76 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+
+#include "../include/lru_cache.hh"
+#include "../include/timed_word_key.hh"
+
+BOOST_AUTO_TEST_SUITE(LRUCacheTest)
+
+  using namespace learnta;
+
+  BOOST_AUTO_TEST_CASE(unbounded) {
+    LRUCache<std::string, int> cache;
+    for (int i = 0; i < 100; ++i) {
+      cache.insert(std::to_string(i), i);
+    }
+    BOOST_CHECK_EQUAL(100, cache.size());
+    for (int i = 0; i < 100; ++i) {
+      BOOST_REQUIRE(cache.find(std::to_string(i)));
+      BOOST_CHECK_EQUAL(i, *cache.find(std::to_string(i)));
+    }
+    BOOST_CHECK(!cache.find("100"));
+    BOOST_CHECK_EQUAL(200, cache.countHits());
+    BOOST_CHECK_EQUAL(1, cache.countMisses());
+    BOOST_CHECK_EQUAL(0, cache.countEvictions());
+  }
+
+  BOOST_AUTO_TEST_CASE(eviction) {
+    LRUCache<std::string, int> cache{2};
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    // "a" becomes the most recently used one
+    BOOST_CHECK(cache.find("a"));
+    cache.insert("c", 3);
+    BOOST_CHECK_EQUAL(2, cache.size());
+    BOOST_CHECK_EQUAL(1, cache.countEvictions());
+    BOOST_CHECK(!cache.find("b"));
+    BOOST_REQUIRE(cache.find("a"));
+    BOOST_CHECK_EQUAL(1, *cache.find("a"));
+    // Update does not evict anything
+    cache.insert("c", 4);
+    BOOST_REQUIRE(cache.find("c"));
+    BOOST_CHECK_EQUAL(4, *cache.find("c"));
+    BOOST_CHECK_EQUAL(1, cache.countEvictions());
+    // Shrink the cache. "c" is the most recently used one.
+    cache.setCapacity(1);
+    BOOST_CHECK_EQUAL(1, cache.size());
+    BOOST_CHECK(cache.find("c"));
+    BOOST_CHECK(!cache.find("a"));
+
+    std::stringstream stream;
+    cache.printStatistics(stream, "test cache");
+    BOOST_CHECK_EQUAL("Size of test cache: 1 / 1\nNumber of hits/misses/evictions of test cache: 6/2/2\n",
+                      stream.str());
+  }
+
+  BOOST_AUTO_TEST_CASE(compatibleKey) {
+    LRUCache<TimedWordKey, bool> cache{1};
+    const TimedWord shortWord{"a", {0.5, 1.0}}, longWord{"aaaaa", {0.5, 1.0, 1.5, 2.0, 2.5, 3.0}};
+    cache.insert(TimedWordKey{shortWord}, true);
+    BOOST_REQUIRE(cache.find(shortWord));
+    BOOST_CHECK(*cache.find(shortWord));
+    BOOST_CHECK(!cache.find(longWord));
+    cache.insert(TimedWordKey{longWord}, false);
+    BOOST_CHECK(!cache.find(shortWord));
+    BOOST_REQUIRE(cache.find(longWord));
+    BOOST_CHECK(!*cache.find(longWord));
+    BOOST_CHECK_EQUAL(4, cache.countHits());
+    BOOST_CHECK_EQUAL(2, cache.countMisses());
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
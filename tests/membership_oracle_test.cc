@@ -0,0 +1,234 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../include/timed_automaton_runner.hh"
+#include "../include/membership_oracle.hh"
+#include "../include/parallel_membership_oracle.hh"
+#include "../include/persistent_membership_oracle.hh"
+
+#include "simple_automaton_fixture.hh"
+
+BOOST_AUTO_TEST_SUITE(MembershipOracleTest)
+
+  using namespace learnta;
+
+  struct SimpleMembershipOracleFixture : public SimpleAutomatonFixture {
+    std::vector<TimedWord> timedWords;
+
+    SimpleMembershipOracleFixture() : SimpleAutomatonFixture() {
+      timedWords.emplace_back("", std::vector<double>{0.3});
+      timedWords.emplace_back("a", std::vector<double>{0.3, 0.8});
+      timedWords.emplace_back("aa", std::vector<double>{0.3, 0.8, 0.3});
+      timedWords.emplace_back("a", std::vector<double>{1.2, 0.3});
+      timedWords.emplace_back("a", std::vector<double>{0.3, 0.8});
+      timedWords.emplace_back("aa", std::vector<double>{1.2, 0.3, 0.5});
+    }
+  };
+
+  BOOST_FIXTURE_TEST_CASE(batchAgreesWithSingle, SimpleMembershipOracleFixture) {
+    SULMembershipOracle single{std::make_unique<TimedAutomatonRunner>(this->automaton)};
+    SULMembershipOracle batch{std::make_unique<TimedAutomatonRunner>(this->automaton)};
+
+    const auto result = batch.answerQueries(timedWords);
+    BOOST_REQUIRE_EQUAL(timedWords.size(), result.size());
+    for (std::size_t i = 0; i < timedWords.size(); ++i) {
+      BOOST_CHECK_EQUAL(single.answerQuery(timedWords.at(i)), result.at(i));
+    }
+    BOOST_CHECK_EQUAL(single.count(), batch.count());
+  }
+
+  BOOST_FIXTURE_TEST_CASE(batchWithCache, SimpleMembershipOracleFixture) {
+    SULMembershipOracle single{std::make_unique<TimedAutomatonRunner>(this->automaton)};
+    MembershipOracleCache cache{std::make_unique<SULMembershipOracle>(std::make_unique<TimedAutomatonRunner>(this->automaton))};
+
+    // The first and the last timed words are given to the cache in advance
+    BOOST_CHECK_EQUAL(single.answerQuery(timedWords.front()), cache.answerQuery(timedWords.front()));
+    BOOST_CHECK_EQUAL(single.answerQuery(timedWords.back()), cache.answerQuery(timedWords.back()));
+    BOOST_CHECK_EQUAL(2, cache.count());
+
+    const auto result = cache.answerQueries(timedWords);
+    BOOST_REQUIRE_EQUAL(timedWords.size(), result.size());
+    for (std::size_t i = 0; i < timedWords.size(); ++i) {
+      BOOST_CHECK_EQUAL(single.answerQuery(timedWords.at(i)), result.at(i));
+    }
+    // Only the three unseen timed words are passed to the SUL
+    BOOST_CHECK_EQUAL(5, cache.count());
+    // Everything is cached now
+    cache.answerQueries(timedWords);
+    BOOST_CHECK_EQUAL(5, cache.count());
+  }
+
+  BOOST_FIXTURE_TEST_CASE(parallel, SimpleMembershipOracleFixture) {
+    SULMembershipOracle single{std::make_unique<TimedAutomatonRunner>(this->automaton)};
+    ParallelMembershipOracle parallel{std::make_unique<TimedAutomatonRunner>(this->automaton), 4};
+
+    std::vector<TimedWord> manyTimedWords;
+    for (int i = 0; i < 50; ++i) {
+      manyTimedWords.insert(manyTimedWords.end(), timedWords.begin(), timedWords.end());
+    }
+    const auto result = parallel.answerQueries(manyTimedWords);
+    BOOST_REQUIRE_EQUAL(manyTimedWords.size(), result.size());
+    for (std::size_t i = 0; i < manyTimedWords.size(); ++i) {
+      BOOST_CHECK_EQUAL(single.answerQuery(manyTimedWords.at(i)), result.at(i));
+    }
+    BOOST_CHECK_EQUAL(manyTimedWords.size(), parallel.count());
+  }
+
+  //! @brief Runner counting the steps fed to it
+  struct StepCountingRunner : public TimedAutomatonRunner {
+    std::size_t numSteps = 0;
+
+    explicit StepCountingRunner(TimedAutomaton automaton) : TimedAutomatonRunner(std::move(automaton)) {}
+
+    bool step(char action) override {
+      ++numSteps;
+      return TimedAutomatonRunner::step(action);
+    }
+
+    bool step(double duration) override {
+      ++numSteps;
+      return TimedAutomatonRunner::step(duration);
+    }
+  };
+
+  BOOST_FIXTURE_TEST_CASE(prefixTrie, SimpleMembershipOracleFixture) {
+    SULMembershipOracle single{std::make_unique<TimedAutomatonRunner>(this->automaton)};
+    StepCountingRunner runner{this->automaton};
+
+    PrefixTrieScheduler::Statistics statistics;
+    const auto result = PrefixTrieScheduler::execute(runner, timedWords, nullptr, &statistics);
+    BOOST_REQUIRE_EQUAL(timedWords.size(), result.size());
+    for (std::size_t i = 0; i < timedWords.size(); ++i) {
+      BOOST_CHECK_EQUAL(single.answerQuery(timedWords.at(i)), result.at(i));
+    }
+    // The trie consists of the branches 0.3 a 0.8 a 0.3 and 1.2 a 0.3 a 0.5, while feeding the words one by one takes 20 steps
+    BOOST_CHECK_EQUAL(10, runner.numSteps);
+    BOOST_CHECK_EQUAL(10, statistics.steps);
+    // One execution from the initial configuration and one execution from the snapshot at the root
+    BOOST_CHECK_EQUAL(2, statistics.executions);
+    // Each of the timed words is still counted as a query
+    BOOST_CHECK_EQUAL(timedWords.size(), runner.count());
+  }
+
+  BOOST_AUTO_TEST_CASE(rejectingSink) {
+    // The DTA accepting the timed words such that each a occurs before one time unit
+    TimedAutomaton automaton;
+    automaton.states.push_back(std::make_shared<TAState>(true));
+    automaton.states.at(0)->next['a'].resize(1);
+    automaton.states.at(0)->next['a'].at(0).target = automaton.states.at(0).get();
+    automaton.states.at(0)->next['a'].at(0).guard = {ConstraintMaker(0) < 1};
+    automaton.states.at(0)->next['a'].at(0).resetVars.emplace_back(0, 0.0);
+    automaton.initialStates.push_back(automaton.states.at(0));
+    automaton.maxConstraints.resize(1);
+    automaton.maxConstraints[0] = 1;
+
+    auto runner = std::make_unique<StepCountingRunner>(automaton);
+    auto &steps = runner->numSteps;
+    SULMembershipOracle oracle{std::move(runner)};
+
+    BOOST_CHECK(!oracle.answerQuery(TimedWord{"a", {1.5, 0.1}}));
+    BOOST_CHECK_EQUAL(1, oracle.count());
+    BOOST_CHECK_EQUAL(2, steps);
+    // The prefix 1.5 a leads to the sink
+    const auto result = oracle.answerQueries({TimedWord{"aa", {1.5, 0.1, 0.2}}, TimedWord{"a", {0.5, 0.1}}});
+    BOOST_CHECK(!result.at(0));
+    BOOST_CHECK(result.at(1));
+    // The timed words rejected without execution are also counted
+    BOOST_CHECK_EQUAL(3, oracle.count());
+    BOOST_CHECK_EQUAL(5, steps);
+    BOOST_CHECK(!oracle.answerQuery(TimedWord{"a", {1.5, 0.3}}));
+    BOOST_CHECK_EQUAL(4, oracle.count());
+    BOOST_CHECK_EQUAL(5, steps);
+  }
+
+  BOOST_AUTO_TEST_CASE(sinkPrefixTrieCapacity) {
+    SinkPrefixTrie trie{5};
+    trie.add(TimedWord{"a", {1.5, 0.1}}, 2);
+    // The longer prefix is redundant
+    trie.add(TimedWord{"aa", {1.5, 0.1, 0.2}}, 4);
+    BOOST_CHECK_EQUAL(2, trie.size());
+    BOOST_CHECK(trie.rejects(TimedWord{"aa", {1.5, 0.1, 0.3}}));
+    trie.add(TimedWord{"a", {2.5, 0.1}}, 3);
+    BOOST_CHECK_EQUAL(5, trie.size());
+    // The shorter prefix replaces the longer one
+    trie.add(TimedWord{"a", {2.5, 0.1}}, 1);
+    BOOST_CHECK_EQUAL(3, trie.size());
+    BOOST_CHECK(trie.rejects(TimedWord{"a", {2.5, 0.2}}));
+    // The trie is cleared since the new nodes exceed the capacity
+    trie.add(TimedWord{"a", {3.5, 0.1}}, 3);
+    BOOST_CHECK_EQUAL(3, trie.size());
+    BOOST_CHECK(!trie.rejects(TimedWord{"a", {1.5, 0.1}}));
+    BOOST_CHECK(!trie.rejects(TimedWord{"a", {2.5, 0.2}}));
+    BOOST_CHECK(trie.rejects(TimedWord{"a", {3.5, 0.1}}));
+  }
+
+  BOOST_FIXTURE_TEST_CASE(persistent, SimpleMembershipOracleFixture) {
+    const auto path = std::filesystem::temp_directory_path() / "learnta_membership_oracle_test.bin";
+    std::filesystem::remove(path);
+    SULMembershipOracle single{std::make_unique<TimedAutomatonRunner>(this->automaton)};
+    // The persistent layer is wrapped by the cache as in SymbolicMembershipOracle::persist
+    auto makeOracle = [&](std::uint64_t fingerprint) {
+      return MembershipOracleCache{std::make_unique<PersistentMembershipOracle>(std::make_unique<SULMembershipOracle>(
+              std::make_unique<TimedAutomatonRunner>(this->automaton)), path, fingerprint)};
+    };
+
+    {
+      auto oracle = makeOracle(1);
+      for (const auto &timedWord: timedWords) {
+        BOOST_CHECK_EQUAL(single.answerQuery(timedWord), oracle.answerQuery(timedWord));
+      }
+      BOOST_CHECK_EQUAL(5, oracle.count());
+    }
+    {
+      // All the answers are in the file
+      auto oracle = makeOracle(1);
+      const auto result = oracle.answerQueries(timedWords);
+      for (std::size_t i = 0; i < timedWords.size(); ++i) {
+        BOOST_CHECK_EQUAL(single.answerQuery(timedWords.at(i)), result.at(i));
+      }
+      BOOST_CHECK_EQUAL(0, oracle.count());
+    }
+    // Simulate a crash while writing the last record
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    {
+      auto oracle = makeOracle(1);
+      const auto result = oracle.answerQueries(timedWords);
+      for (std::size_t i = 0; i < timedWords.size(); ++i) {
+        BOOST_CHECK_EQUAL(single.answerQuery(timedWords.at(i)), result.at(i));
+      }
+      BOOST_CHECK_EQUAL(1, oracle.count());
+    }
+    {
+      // The file is for another target
+      auto oracle = makeOracle(2);
+      for (const auto &timedWord: timedWords) {
+        BOOST_CHECK_EQUAL(single.answerQuery(timedWord), oracle.answerQuery(timedWord));
+      }
+      BOOST_CHECK_EQUAL(5, oracle.count());
+    }
+    std::filesystem::remove(path);
+  }
+
+  struct NonClonableSUL : public SUL {
+    void pre() override {}
+    void post() override {}
+    bool step(char) override {
+      return false;
+    }
+    bool step(double) override {
+      return false;
+    }
+    [[nodiscard]] std::size_t count() const override {
+      return 0;
+    }
+  };
+
+  BOOST_AUTO_TEST_CASE(parallelWithoutClone) {
+    BOOST_CHECK_NO_THROW(ParallelMembershipOracle(std::make_unique<NonClonableSUL>(), 1));
+    BOOST_CHECK_THROW(ParallelMembershipOracle(std::make_unique<NonClonableSUL>(), 2), std::invalid_argument);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
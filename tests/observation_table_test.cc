@@ -4,6 +4,7 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <boost/test/unit_test.hpp>
 
 #define private public
@@ -13,6 +14,7 @@
 #include "../include/symbolic_membership_oracle.hh"
 #include "../include/equivalence_oracle.hh"
 #include "../include/timed_automata_equivalence_oracle.hh"
+#include "../include/persistent_membership_oracle.hh"
 
 #include "simple_automaton_fixture.hh"
 #include "simple_observation_table_keys_fixture.hh"
@@ -70,6 +72,107 @@ BOOST_AUTO_TEST_SUITE(ObservationTableTest)
      */
   }
 
+  BOOST_FIXTURE_TEST_CASE(checkpoint, SimpleAutomatonOracleFixture) {
+    observationTable.moveToP(2);
+    while (!observationTable.close()) {}
+    std::stringstream description;
+    description << this->automaton;
+    const auto fingerprint = PersistentMembershipOracle::fingerprint(description.str());
+    std::stringstream stream;
+    observationTable.save(stream, fingerprint);
+
+    auto oracle = std::make_unique<learnta::SymbolicMembershipOracle>(
+            std::unique_ptr<learnta::SUL>(new learnta::TimedAutomatonRunner{this->automaton}));
+    const auto *oraclePtr = oracle.get();
+    ObservationTable restored{alphabet, std::move(oracle)};
+    // The initial table is filled by the constructor
+    const auto initialCount = oraclePtr->count();
+    restored.load(stream, fingerprint);
+
+    BOOST_CHECK(observationTable.prefixes == restored.prefixes);
+    BOOST_CHECK(observationTable.suffixes == restored.suffixes);
+    BOOST_CHECK(observationTable.pIndices == restored.pIndices);
+    BOOST_CHECK(observationTable.continuousSuccessors == restored.continuousSuccessors);
+    BOOST_CHECK(observationTable.discreteSuccessors == restored.discreteSuccessors);
+    BOOST_CHECK_EQUAL(observationTable.signatures.size(), restored.signatures.size());
+    for (std::size_t i = 0; i < observationTable.prefixes.size(); ++i) {
+      BOOST_CHECK_EQUAL(observationTable.signatures.at(i), restored.signatures.at(i));
+      for (std::size_t j = 0; j < observationTable.suffixes.size(); ++j) {
+        BOOST_CHECK(observationTable.concatenations.at(i, j) == restored.concatenations.at(i, j));
+        BOOST_CHECK(observationTable.table.at(i, j).getConditions() == restored.table.at(i, j).getConditions());
+      }
+    }
+    BOOST_CHECK(restored.close());
+    BOOST_CHECK_EQUAL(observationTable.generateHypothesis().stateSize(), restored.generateHypothesis().stateSize());
+    // No membership query is made to restore the table
+    BOOST_CHECK_EQUAL(initialCount, oraclePtr->count());
+
+    // A checkpoint for another alphabet is rejected
+    ObservationTable another{{'a', 'b'}, std::make_unique<learnta::SymbolicMembershipOracle>(
+            std::unique_ptr<learnta::SUL>(new learnta::TimedAutomatonRunner{this->automaton}))};
+    std::stringstream anotherStream{stream.str()};
+    BOOST_CHECK_THROW(another.load(anotherStream, fingerprint), std::invalid_argument);
+    // A checkpoint for another target is rejected
+    std::stringstream complementDescription;
+    complementDescription << this->complementAutomaton;
+    std::stringstream anotherTargetStream{stream.str()};
+    BOOST_CHECK_THROW(restored.load(anotherTargetStream,
+                                    PersistentMembershipOracle::fingerprint(complementDescription.str())),
+                      std::invalid_argument);
+    // A truncated checkpoint is rejected
+    std::stringstream truncated{stream.str().substr(0, stream.str().size() / 2)};
+    BOOST_CHECK_THROW(restored.load(truncated, fingerprint), std::invalid_argument);
+  }
+
+  BOOST_FIXTURE_TEST_CASE(minimizeSuffixes, SimpleAutomatonOracleFixture) {
+    observationTable.moveToP(2);
+    while (!observationTable.close()) {}
+    const auto expectedStateSize = observationTable.generateHypothesis().stateSize();
+    const auto suffixes = observationTable.suffixes;
+    const auto numRows = observationTable.prefixes.size();
+    std::vector<std::vector<TimedConditionSet>> rows;
+    for (std::size_t i = 0; i < numRows; ++i) {
+      rows.push_back(observationTable.table.row(i).toVector());
+    }
+
+    // A copy of an existing suffix never changes the equivalence
+    observationTable.suffixes.push_back(observationTable.suffixes.front());
+    observationTable.refreshTable();
+    BOOST_CHECK_EQUAL(1, observationTable.minimizeSuffixes());
+
+    BOOST_CHECK(suffixes == observationTable.suffixes);
+    BOOST_CHECK_EQUAL(suffixes.size(), observationTable.table.columns());
+    BOOST_REQUIRE_EQUAL(numRows, observationTable.prefixes.size());
+    for (std::size_t i = 0; i < numRows; ++i) {
+      const auto row = observationTable.table.row(i);
+      BOOST_REQUIRE_EQUAL(rows.at(i).size(), row.size());
+      for (std::size_t j = 0; j < row.size(); ++j) {
+        BOOST_CHECK(rows.at(i).at(j).getConditions() == row.at(j).getConditions());
+      }
+    }
+    BOOST_CHECK(observationTable.close());
+    BOOST_CHECK_EQUAL(expectedStateSize, observationTable.generateHypothesis().stateSize());
+    // The first suffix is never removed
+    BOOST_CHECK_EQUAL(0, observationTable.minimizeSuffixes());
+  }
+
+  BOOST_FIXTURE_TEST_CASE(minimizeCounterexampleSuffix, SimpleAutomatonOracleFixture) {
+    observationTable.moveToP(2);
+    while (!observationTable.close()) {}
+    const auto suffixes = observationTable.suffixes;
+    const auto expectedStateSize = observationTable.generateHypothesis().stateSize();
+
+    // The suffix is added as in handleCEX. Since the target has no invariant, waiting 0.5 does not change the acceptance,
+    // and the suffix is redundant although it is not a copy of the first suffix.
+    observationTable.suffixes.push_back(BackwardRegionalElementaryLanguage::fromTimedWord(TimedWord{"", {0.5}}));
+    observationTable.refreshTable();
+    BOOST_CHECK(!(suffixes.front() == observationTable.suffixes.back()));
+    BOOST_CHECK_EQUAL(1, observationTable.minimizeSuffixes());
+    BOOST_CHECK(suffixes == observationTable.suffixes);
+    BOOST_CHECK(observationTable.close());
+    BOOST_CHECK_EQUAL(expectedStateSize, observationTable.generateHypothesis().stateSize());
+  }
+
   BOOST_AUTO_TEST_CASE(stateSplitTest) {
     const auto toTA = [] (std::vector<std::shared_ptr<TAState>> states) {
       return TimedAutomaton{{states, {states.front()}}, TimedAutomaton::makeMaxConstants(states)}.simplify();
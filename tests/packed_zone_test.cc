@@ -0,0 +1,247 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include "../include/packed_zone.hh"
+#include "../include/ta2za.hh"
+
+#include "light_automaton_fixture.hh"
+#include "unbalanced_fixture.hh"
+
+BOOST_AUTO_TEST_SUITE(PackedZoneTest)
+
+  using namespace learnta;
+
+  BOOST_AUTO_TEST_CASE(bounds) {
+    const std::vector<Bounds> bounds = {{-3, false}, {-3, true}, {0, false}, {0, true}, {2, false}, {2, true},
+                                        {std::numeric_limits<double>::max(), false}};
+    for (const auto &left: bounds) {
+      BOOST_CHECK_EQUAL(left, unpackBounds(packBounds(left)));
+      for (const auto &right: bounds) {
+        // The order and the sum are preserved
+        BOOST_CHECK_EQUAL(left < right, packBounds(left) < packBounds(right));
+        const auto sum = left + right;
+        if (sum.first >= std::numeric_limits<double>::max()) {
+          BOOST_CHECK_EQUAL(packedInfinity, addPackedBounds(packBounds(left), packBounds(right)));
+        } else {
+          BOOST_CHECK_EQUAL(sum, unpackBounds(addPackedBounds(packBounds(left), packBounds(right))));
+        }
+      }
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(canonize) {
+    Zone zone = Zone::top(4);
+    zone.tighten(std::vector<Constraint>{ConstraintMaker(0) < 3, ConstraintMaker(1) >= 1, ConstraintMaker(2) <= 2});
+    zone.tighten(0, 1, Bounds{1, false});
+    PackedZone packed{Zone::top(4)};
+    packed.tighten(std::vector<Constraint>{ConstraintMaker(0) < 3, ConstraintMaker(1) >= 1, ConstraintMaker(2) <= 2});
+    packed.tighten(0, 1, packBounds(1, false));
+    zone.canonize();
+    packed.canonize();
+    BOOST_CHECK(zone == packed.toZone());
+    BOOST_CHECK_EQUAL(hash_value(zone), hash_value(packed));
+    BOOST_CHECK(packed.isSatisfiable());
+
+    packed.tighten(std::vector<Constraint>{ConstraintMaker(0) > 3});
+    BOOST_CHECK(!packed.isSatisfiable());
+  }
+
+  BOOST_AUTO_TEST_CASE(unsatisfiableLargeConstants) {
+    // Each guard is satisfiable, but they contradict each other with the largest constant
+    const std::vector<Constraint> guards{ConstraintMaker(0) >= maxPackedConstant, ConstraintMaker(1) >= maxPackedConstant,
+                                         ConstraintMaker(0) <= 0, ConstraintMaker(2) < maxPackedConstant};
+    Zone top = Zone::top(4);
+    top.maxConstraints = {maxPackedConstant, maxPackedConstant, maxPackedConstant};
+    PackedZone dynamic{top};
+    BasicPackedZone<4> fixed{top};
+    // Closing the unsatisfiable zones again and again must not make the bounds keep decreasing and overflow
+    for (int i = 0; i < 20; ++i) {
+      dynamic.tighten(guards);
+      fixed.tighten(guards);
+      dynamic.canonize();
+      fixed.canonize();
+    }
+    BOOST_CHECK(!dynamic.isSatisfiable());
+    BOOST_CHECK(!fixed.isSatisfiable());
+    const PackedBounds lowest = 4 * packBounds(-maxPackedConstant, false);
+    BOOST_CHECK((dynamic.value.array() >= lowest).all());
+    BOOST_CHECK((fixed.value.array() >= lowest).all());
+  }
+
+  //! @brief A random DBM constraining a random point. Some bounds are infinity.
+  static Zone randomZone(Eigen::Index size, std::mt19937 &engine) {
+    std::uniform_int_distribution<int> point{0, 20}, slack{0, 5}, coin{0, 3};
+    std::vector<int> valuation(size, 0);
+    for (Eigen::Index i = 1; i < size; ++i) {
+      valuation.at(i) = point(engine);
+    }
+    Zone zone = Zone::top(size);
+    for (Eigen::Index i = 0; i < size; ++i) {
+      for (Eigen::Index j = 0; j < size; ++j) {
+        if (i == j) {
+          zone.value(i, j) = Bounds{0, true};
+        } else if (coin(engine) != 0) {
+          zone.value(i, j) = Bounds{valuation.at(i) - valuation.at(j) + slack(engine), coin(engine) != 0};
+        }
+      }
+    }
+    return zone;
+  }
+
+  BOOST_AUTO_TEST_CASE(canonizeKernels) {
+    std::mt19937 engine{2026};
+    const auto avx2 = packedCloseKernelAvx2();
+    for (const Eigen::Index size: {2, 5, 8, 9, 17}) {
+      for (int trial = 0; trial < 50; ++trial) {
+        Zone zone = randomZone(size, engine);
+        PackedZone scalar{zone};
+        scalar.canonize(closePackedDBM);
+        if (avx2) {
+          PackedZone vectorized{zone};
+          vectorized.canonize(avx2);
+          BOOST_CHECK(scalar == vectorized);
+        }
+        if (scalar.isSatisfiableNoCanonize()) {
+          zone.canonize();
+          BOOST_CHECK(zone == scalar.toZone());
+        }
+      }
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(fixedDimension) {
+    std::mt19937 engine{2026};
+    for (int trial = 0; trial < 50; ++trial) {
+      Zone zone = randomZone(4, engine);
+      zone.maxConstraints = {2, 3, 5};
+      PackedZone dynamic{zone};
+      BasicPackedZone<4> fixed{zone};
+      BOOST_CHECK_EQUAL(hash_value(dynamic), hash_value(fixed));
+      BOOST_CHECK_EQUAL(dynamic.isSatisfiable(), fixed.isSatisfiable());
+      BOOST_CHECK(dynamic.toZone() == fixed.toZone());
+      dynamic.tighten(std::vector<Constraint>{ConstraintMaker(1) > 4});
+      fixed.tighten(std::vector<Constraint>{ConstraintMaker(1) > 4});
+      dynamic.elapse();
+      fixed.elapse();
+      dynamic.extrapolate();
+      fixed.extrapolate();
+      BOOST_CHECK(dynamic.toZone() == fixed.toZone());
+      BOOST_CHECK(fixed.includes(BasicPackedZone<4>{dynamic.toZone()}));
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(extrapolateLU) {
+    std::mt19937 engine{2026};
+    const std::vector<int> lowerBounds{2, 0, 5}, upperBounds{4, 1, 3};
+    for (int trial = 0; trial < 50; ++trial) {
+      Zone zone = randomZone(4, engine);
+      zone.maxConstraints = {5, 1, 5};
+      if (!zone.isSatisfiable()) {
+        continue;
+      }
+      zone.elapse();
+      zone.canonize();
+      PackedZone dynamic{zone};
+      BasicPackedZone<4> fixed{zone};
+      zone.extrapolateLU(lowerBounds, upperBounds);
+      dynamic.extrapolateLU(lowerBounds, upperBounds);
+      fixed.extrapolateLU(lowerBounds, upperBounds);
+      BOOST_CHECK(zone == dynamic.toZone());
+      BOOST_CHECK(zone == fixed.toZone());
+    }
+  }
+
+  BOOST_AUTO_TEST_CASE(applyResetsCanonical) {
+    using Resets = std::vector<std::pair<ClockVariables, std::variant<double, ClockVariables>>>;
+    const std::vector<Resets> resetsList = {
+            {{0, ClockVariables{1}}},
+            {{1, 2.0}},
+            {{0, ClockVariables{2}}, {2, 0.0}},
+            {{1, ClockVariables{0}}, {0, 3.0}, {2, ClockVariables{1}}},
+    };
+    std::mt19937 engine{2026};
+    for (int trial = 0; trial < 100; ++trial) {
+      Zone zone = randomZone(4, engine);
+      zone.maxConstraints = {2, 3, 5};
+      if (!zone.isSatisfiable()) {
+        continue;
+      }
+      if (trial % 2 == 0) {
+        // Make the special variable 0 unconstrained as in ta2za
+        zone.elapse();
+        zone.canonize();
+      }
+      for (const auto &resets: resetsList) {
+        Zone expected = zone;
+        expected.applyResets(resets);
+        expected.canonize();
+        Zone actual = zone;
+        actual.applyResetsCanonical(resets);
+        BOOST_CHECK(expected == actual);
+
+        PackedZone packed{zone};
+        packed.applyResetsCanonical(resets);
+        BOOST_CHECK(expected == packed.toZone());
+        BasicPackedZone<4> fixed{zone};
+        fixed.applyResetsCanonical(resets);
+        BOOST_CHECK(expected == fixed.toZone());
+      }
+    }
+  }
+
+  //! @brief The zone automata constructed with Zone and PackedZone are the same
+  static void checkSameZoneAutomaton(const TimedAutomaton &automaton, bool quickReturn) {
+    ZoneAutomaton expected, packed;
+    ta2za(automaton, expected, quickReturn, false);
+    ta2za(automaton, packed, quickReturn, true);
+    BOOST_REQUIRE_EQUAL(expected.states.size(), packed.states.size());
+    for (std::size_t i = 0; i < expected.states.size(); ++i) {
+      BOOST_CHECK_EQUAL(expected.states.at(i)->taState, packed.states.at(i)->taState);
+      BOOST_CHECK(expected.states.at(i)->zone == packed.states.at(i)->zone);
+      BOOST_CHECK_EQUAL(expected.states.at(i)->next.size(), packed.states.at(i)->next.size());
+    }
+  }
+
+  BOOST_FIXTURE_TEST_CASE(ta2zaLight, LightAutomatonFixture) {
+    checkSameZoneAutomaton(targetAutomaton, false);
+    checkSameZoneAutomaton(complementTargetAutomaton, false);
+    checkSameZoneAutomaton(complementTargetAutomaton, true);
+  }
+
+  BOOST_FIXTURE_TEST_CASE(ta2zaUnbalanced, UnbalancedHypothesis20221219Fixture) {
+    checkSameZoneAutomaton(hypothesis, false);
+    checkSameZoneAutomaton(hypothesis, true);
+  }
+
+  //! @brief A timed automaton with more clock variables than the fixed-size zones support
+  BOOST_AUTO_TEST_CASE(ta2zaManyClocks) {
+    constexpr ClockVariables clockSize = maxFixedPackedZoneDimension;
+    TimedAutomaton automaton;
+    for (ClockVariables x = 0; x <= clockSize; ++x) {
+      automaton.states.push_back(std::make_shared<TAState>(x == clockSize));
+    }
+    automaton.initialStates.push_back(automaton.states.front());
+    // A chain of transitions resetting or renaming the clock variables one by one
+    for (ClockVariables x = 0; x < clockSize; ++x) {
+      TATransition::Resets resets{{x, 0.0}};
+      if (x > 0) {
+        resets.emplace_back(x - 1, x);
+      }
+      automaton.states.at(x)->next['a'].emplace_back(automaton.states.at(x + 1).get(), resets,
+                                                     std::vector<Constraint>{ConstraintMaker(x) <= x + 1});
+      automaton.states.at(x)->next['b'].emplace_back(automaton.states.at(x).get(), TATransition::Resets{},
+                                                     std::vector<Constraint>{ConstraintMaker(x) > 3});
+    }
+    automaton.maxConstraints = TimedAutomaton::makeMaxConstants(automaton.states);
+    BOOST_REQUIRE_EQUAL(clockSize, automaton.clockSize());
+
+    checkSameZoneAutomaton(automaton, false);
+    checkSameZoneAutomaton(automaton, true);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,6 +7,7 @@
 #include <boost/test/unit_test.hpp>
 
 #define protected public
+#define private public
 
 #include "../include/timed_automaton_runner.hh"
 #include "../include/symbolic_membership_oracle.hh"
@@ -84,4 +85,56 @@ BOOST_AUTO_TEST_SUITE(SymbolicMembershipOracleTest)
     BOOST_CHECK_EQUAL(expected, resultP5S3.front());
   }
 
+  BOOST_FIXTURE_TEST_CASE(simpleCache, SimpleAutomatonOracleFixture) {
+    auto p5s3 = p5 + s3;
+    auto resultP5S3 = this->oracle->query(p5s3);
+    const auto simpleLanguages = p5s3.enumerate();
+    const auto misses = this->oracle->simpleCache.countMisses();
+    BOOST_CHECK_EQUAL(simpleLanguages.size(), misses);
+    // The simple elementary languages are answered by the cache
+    for (const auto &simple: simpleLanguages) {
+      auto result = this->oracle->query(simple);
+      BOOST_CHECK_EQUAL(result.empty(), std::none_of(resultP5S3.getConditions().begin(),
+                                                     resultP5S3.getConditions().end(),
+                                                     [&](const TimedCondition &condition) {
+                                                       return condition.includes(simple.getTimedCondition());
+                                                     }));
+    }
+    BOOST_CHECK_EQUAL(misses, this->oracle->simpleCache.countMisses());
+  }
+
+  BOOST_FIXTURE_TEST_CASE(reduceWithExcluded, SimpleAutomatonOracleFixture) {
+    for (const auto &elementary: {p2 + s3, p5 + s3, p10 + s3, p13 + s3}) {
+      std::list<ElementaryLanguage> includedLanguages;
+      std::vector<TimedCondition> included, excluded;
+      for (const auto &simple: elementary.enumerate()) {
+        if (this->oracle->query(simple).empty()) {
+          excluded.push_back(simple.getTimedCondition());
+        } else {
+          included.push_back(simple.getTimedCondition());
+          includedLanguages.push_back(simple);
+        }
+      }
+      const auto expected = TimedConditionSet::reduce(includedLanguages);
+      const auto result = TimedConditionSet::reduce(included, excluded);
+      BOOST_CHECK(expected.getConditions() == result.getConditions());
+    }
+  }
+
+  BOOST_FIXTURE_TEST_CASE(parallelQueries, SimpleAutomatonOracleFixture) {
+    const std::vector<ElementaryLanguage> elementaryLanguages{p1 + s1, p2 + s3, p5 + s3, p10 + s3, p2 + s3, p4 + s1};
+    ThreadPool pool{4};
+    const auto results = this->oracle->queries(elementaryLanguages, &pool);
+    BOOST_REQUIRE_EQUAL(elementaryLanguages.size(), results.size());
+    // p2 + s3 is queried only once
+    BOOST_CHECK_EQUAL(elementaryLanguages.size(), this->oracle->countSymbolic);
+    BOOST_CHECK_EQUAL(elementaryLanguages.size() - 1, this->oracle->countSymbolicWithCache);
+
+    auto runner = std::unique_ptr<learnta::SUL>(new learnta::TimedAutomatonRunner{automaton});
+    SymbolicMembershipOracle sequentialOracle{std::move(runner)};
+    for (std::size_t i = 0; i < elementaryLanguages.size(); ++i) {
+      BOOST_CHECK(sequentialOracle.query(elementaryLanguages.at(i)).getConditions() == results.at(i).getConditions());
+    }
+  }
+
 BOOST_AUTO_TEST_SUITE_END()
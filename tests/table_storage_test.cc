@@ -0,0 +1,73 @@
+/**
+ * @date 2026/10/16.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../include/table_storage.hh"
+
+BOOST_AUTO_TEST_SUITE(TableStorageTest)
+
+  using namespace learnta;
+
+  BOOST_AUTO_TEST_CASE(grow) {
+    TableStorage<int> table;
+    table.resize(2, 1);
+    table.at(0, 0) = 0;
+    table.at(1, 0) = 10;
+    // Add rows and columns alternately as in the observation table
+    for (std::size_t columns = 2; columns <= 5; ++columns) {
+      const auto rows = table.rows();
+      table.resize(rows + 1, columns);
+      for (std::size_t i = 0; i < table.rows(); ++i) {
+        for (std::size_t j = 0; j < columns; ++j) {
+          if (i < rows && j + 1 < columns) {
+            // The existing cells are kept
+            BOOST_CHECK_EQUAL(10 * i + j, table.at(i, j));
+          } else {
+            table.at(i, j) = static_cast<int>(10 * i + j);
+          }
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(6, table.rows());
+    BOOST_CHECK_EQUAL(5, table.columns());
+    for (std::size_t i = 0; i < table.rows(); ++i) {
+      const auto row = table.row(i);
+      BOOST_REQUIRE_EQUAL(5, row.size());
+      for (std::size_t j = 0; j < row.size(); ++j) {
+        BOOST_CHECK_EQUAL(10 * i + j, row.at(j));
+      }
+    }
+    BOOST_CHECK_THROW((void) table.row(6), std::out_of_range);
+  }
+
+  BOOST_AUTO_TEST_CASE(eraseColumn) {
+    TableStorage<int> table;
+    table.resize(2, 3);
+    for (std::size_t i = 0; i < 2; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        table.at(i, j) = static_cast<int>(10 * i + j);
+      }
+    }
+    table.eraseColumn(1);
+    BOOST_CHECK_EQUAL(2, table.columns());
+    BOOST_CHECK((table.row(0).toVector() == std::vector<int>{0, 2}));
+    BOOST_CHECK((table.row(1).toVector() == std::vector<int>{10, 12}));
+    // The column added later is default-constructed
+    table.resize(2, 3);
+    BOOST_CHECK((table.row(1).toVector() == std::vector<int>{10, 12, 0}));
+    BOOST_CHECK_THROW(table.eraseColumn(3), std::out_of_range);
+  }
+
+  BOOST_AUTO_TEST_CASE(view) {
+    const std::vector<int> vector{1, 2, 3};
+    RowView<int> view = vector;
+    BOOST_CHECK_EQUAL(3, view.size());
+    BOOST_CHECK_EQUAL(1, view.front());
+    BOOST_CHECK_EQUAL(3, view.back());
+    BOOST_CHECK(vector == view.toVector());
+    BOOST_CHECK_THROW(view.at(3), std::out_of_range);
+  }
+
+BOOST_AUTO_TEST_SUITE_END()
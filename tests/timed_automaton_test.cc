@@ -7,6 +7,7 @@
 #include <sstream>
 
 #include "../include/timed_automaton.hh"
+#include "../include/ta2za.hh"
 
 #include "simple_automaton_fixture.hh"
 #include "unbalanced_fixture.hh"
@@ -120,4 +121,52 @@ BOOST_AUTO_TEST_SUITE(TimedAutomatonTest)
                                            ConstraintMaker(0) > 5, ConstraintMaker(1) < 6};
     BOOST_CHECK_EQUAL(sort(expectedGuards), sort(states.at(0)->next.at('b').front().guard));
   }
+
+  BOOST_AUTO_TEST_CASE(makeLUBounds) {
+    std::vector<std::shared_ptr<TAState>> states;
+    for (int i = 0; i < 3; ++i) {
+      states.push_back(std::make_shared<TAState>(i == 2));
+    }
+    states.at(0)->next['a'].emplace_back(states.at(1).get(), TATransition::Resets{{1, ClockVariables{0}}},
+                                         std::vector<Constraint>{ConstraintMaker(0) < 2});
+    states.at(1)->next['b'].emplace_back(states.at(2).get(), TATransition::Resets{{0, 0.0}},
+                                         std::vector<Constraint>{ConstraintMaker(1) > 5, ConstraintMaker(0) <= 3});
+    states.at(2)->next['c'].emplace_back(states.at(2).get(), TATransition::Resets{},
+                                         std::vector<Constraint>{ConstraintMaker(0) > 4});
+    const TimedAutomaton automaton{{states, {states.front()}}, TimedAutomaton::makeMaxConstants(states)};
+    const auto bounds = automaton.makeLUBounds();
+
+    BOOST_CHECK_EQUAL(3, bounds.size());
+    // The bound of x1 at loc1 is propagated to x0 at loc0 through the renaming x1 := x0
+    BOOST_TEST(bounds.at(states.at(0).get()).lowerBounds == (std::vector<int>{5, 0}));
+    BOOST_TEST(bounds.at(states.at(0).get()).upperBounds == (std::vector<int>{3, 0}));
+    // The bound of x0 at loc2 is not propagated through the assignment x0 := 0
+    BOOST_TEST(bounds.at(states.at(1).get()).lowerBounds == (std::vector<int>{0, 5}));
+    BOOST_TEST(bounds.at(states.at(1).get()).upperBounds == (std::vector<int>{3, 0}));
+    BOOST_TEST(bounds.at(states.at(2).get()).lowerBounds == (std::vector<int>{4, 0}));
+    BOOST_TEST(bounds.at(states.at(2).get()).upperBounds == (std::vector<int>{0, 0}));
+  }
+
+  BOOST_AUTO_TEST_CASE(makeLUBoundsOutsideTarget) {
+    // The target of the transition is not in the states of the automaton
+    auto outside = std::make_shared<TAState>(true);
+    outside->next['b'].emplace_back(outside.get(), TATransition::Resets{},
+                                    std::vector<Constraint>{ConstraintMaker(0) > 1});
+    std::vector<std::shared_ptr<TAState>> states{std::make_shared<TAState>(false)};
+    states.front()->next['a'].emplace_back(outside.get(), TATransition::Resets{},
+                                           std::vector<Constraint>{ConstraintMaker(0) < 1});
+    const TimedAutomaton automaton{{states, {states.front()}}, std::vector<int>{3}};
+    const auto bounds = automaton.makeLUBounds();
+
+    BOOST_CHECK_EQUAL(1, bounds.size());
+    // The bounds of the target are the maximum constants
+    BOOST_TEST(bounds.at(states.front().get()).lowerBounds == (std::vector<int>{3}));
+    BOOST_TEST(bounds.at(states.front().get()).upperBounds == (std::vector<int>{3}));
+    // ta2za also uses the maximum constants for the target
+    ZoneAutomaton zoneAutomaton;
+    BOOST_CHECK_NO_THROW(ta2za(automaton, zoneAutomaton, false));
+    BOOST_CHECK(std::any_of(zoneAutomaton.states.begin(), zoneAutomaton.states.end(), [&](const auto &state) {
+      return state->taState == outside.get();
+    }));
+  }
 BOOST_AUTO_TEST_SUITE_END()
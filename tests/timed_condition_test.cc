@@ -124,6 +124,38 @@ BOOST_AUTO_TEST_SUITE(TimedConditionTest)
     }
   }
 
+  BOOST_AUTO_TEST_CASE(forEachSimple) {
+    TimedCondition nonSimple;
+    // nonSimple is \tau_0 \in (0,1) && \tau_0 + \tau_1 = (1,2) && \tau_1 \in (0,2) as in enumerate
+    nonSimple.zone = Zone::top(3);
+    nonSimple.zone.value(1, 2) = Bounds{1, false};
+    nonSimple.zone.value(2, 1) = Bounds{0, false};
+    nonSimple.zone.value(1, 0) = Bounds{2, false};
+    nonSimple.zone.value(0, 1) = Bounds{-1, false};
+    nonSimple.zone.value(2, 0) = Bounds{2, false};
+    nonSimple.zone.value(0, 2) = Bounds{0, false};
+
+    // The same simple conditions as enumerate
+    const auto expected = nonSimple.enumerate();
+    std::vector<TimedCondition> simpleConditions;
+    BOOST_CHECK(nonSimple.forEachSimple([&](const TimedCondition &simple) {
+      simpleConditions.push_back(simple);
+      return true;
+    }));
+    BOOST_CHECK_EQUAL(expected.size(), simpleConditions.size());
+    for (const auto &simple: simpleConditions) {
+      BOOST_CHECK(simple.isSimple());
+      BOOST_CHECK(std::find(expected.begin(), expected.end(), simple) != expected.end());
+    }
+
+    // Stop the enumeration
+    std::size_t count = 0;
+    BOOST_CHECK(!nonSimple.forEachSimple([&](const TimedCondition &) {
+      return ++count < 2;
+    }));
+    BOOST_CHECK_EQUAL(2, count);
+  }
+
   BOOST_AUTO_TEST_CASE(enumurate20220918) {
     TimedCondition condition;
     std::stringstream stream;
@@ -6,6 +6,7 @@
 #include <boost/test/unit_test.hpp>
 #include <sstream>
 #include "../include/timed_word.hh"
+#include "../include/timed_word_key.hh"
 
 BOOST_AUTO_TEST_SUITE(TimedWordTest)
 
@@ -56,4 +57,22 @@ BOOST_AUTO_TEST_SUITE(TimedWordTest)
     std::vector<double> expectedAccumulatedDurations = {2.75, 1.25, 0.75};
     BOOST_TEST(accumulatedDurations == expectedAccumulatedDurations, boost::test_tools::per_element());
   }
+
+  BOOST_AUTO_TEST_CASE(key) {
+    const TimedWord shortWord{"ab", {0.8, 1.2, 3.0}};
+    const TimedWord longWord{"abababababab", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}};
+    const TimedWordKey shortKey{shortWord};
+    const TimedWordKey longKey{longWord};
+    BOOST_CHECK_EQUAL(shortWord, shortKey.toTimedWord());
+    BOOST_CHECK_EQUAL(longWord, longKey.toTimedWord());
+    BOOST_CHECK(shortKey == TimedWordKey(TimedWord{"ab", {0.8, 1.2, 3.0}}));
+    BOOST_CHECK(shortKey != TimedWordKey(TimedWord{"ab", {0.8, 1.2, 3.5}}));
+    BOOST_CHECK(shortKey != TimedWordKey(TimedWord{"aa", {0.8, 1.2, 3.0}}));
+    BOOST_CHECK(shortKey != longKey);
+    BOOST_CHECK_EQUAL(hash_value(shortWord), hash_value(shortKey));
+    BOOST_CHECK_EQUAL(boost::hash_value(std::make_tuple(longWord.getWord(), longWord.getDurations())),
+                      hash_value(longWord));
+    BOOST_CHECK(shortKey == shortWord);
+    BOOST_CHECK(!(shortKey == longWord));
+  }
 BOOST_AUTO_TEST_SUITE_END()
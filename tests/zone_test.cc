@@ -152,6 +152,40 @@ x2 >= 1, x3 >= 1, x5 := x4, x6 := x4, x7 := x4,
      */
   }
 
+  BOOST_AUTO_TEST_CASE(extrapolateLU) {
+    // 7 <= x0 <= 9, 0 <= x1 <= 2, and x0 - x1 = 7
+    auto zone = Zone::top(3);
+    zone.value.diagonal().fill(Bounds{0, true});
+    zone.value(0, 2) = Bounds{0, true};
+    zone.tighten(ConstraintMaker(0) >= 7);
+    zone.tighten(ConstraintMaker(1) <= 2);
+    zone.tighten(0, 1, Bounds{7, true});
+    zone.canonize();
+    BOOST_TEST((Bounds{9, true} == zone.value(1, 0)));
+    BOOST_TEST((Bounds{-5, true} == zone.value(2, 1)));
+
+    auto lu = zone;
+    lu.extrapolateLU({3, 1}, {5, 2});
+    // The bounds of x0 exceed its lower bound, and the lower bound of x0 exceeds its upper bound
+    BOOST_TEST((Bounds{-5, false} == lu.value(0, 1)));
+    BOOST_TEST((Bounds{0, true} == lu.value(0, 2)));
+    BOOST_TEST((Bounds{std::numeric_limits<double>::max(), false} == lu.value(1, 0)));
+    BOOST_TEST((Bounds{std::numeric_limits<double>::max(), false} == lu.value(1, 2)));
+    BOOST_TEST((Bounds{std::numeric_limits<double>::max(), false} == lu.value(2, 0)));
+    BOOST_TEST((Bounds{std::numeric_limits<double>::max(), false} == lu.value(2, 1)));
+    lu.canonize();
+    BOOST_TEST(lu.includes(zone));
+
+    // The extrapolation with the maximum constants keeps x1 <= 2
+    auto max = zone;
+    max.maxConstraints = {5, 2};
+    max.extrapolate();
+    max.value.diagonal().fill(Bounds{0, true});
+    max.canonize();
+    BOOST_TEST(lu.includes(max));
+    BOOST_TEST(!max.includes(lu));
+  }
+
   BOOST_AUTO_TEST_CASE(equalTighten) {
     // Construct the initial zone
     auto zone = Zone::top(2);